@@ -0,0 +1,27 @@
+#include <Azteck.h>
+
+#include "Azteck/Core/JobSystem.h"
+
+#include "Benchmark.h"
+
+int main(int argc, char** argv)
+{
+	Azteck::Log::init();
+
+	// Fonts and other engine assets are looked up relative to the editor
+	if (std::filesystem::exists("../Azteck-Editor"))
+		std::filesystem::current_path("../Azteck-Editor");
+
+	// Nothing is drawn, the renderer runs on the recording backend
+	Azteck::RendererAPI::setAPI(Azteck::RendererAPI::API::Headless);
+
+	Azteck::JobSystem::init();
+	Azteck::Renderer::init();
+
+	int result = Azteck::BenchmarkRunner::run(argc, argv);
+
+	Azteck::Renderer::shutdown();
+	Azteck::JobSystem::shutdown();
+
+	return result;
+}
@@ -0,0 +1,260 @@
+#include "Benchmark.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		// Guards against benchmarks that never reach the minimum time
+		static constexpr uint64_t maxBenchmarkIterations = 1000000000;
+
+		static std::string formatDuration(double seconds)
+		{
+			char buffer[32];
+
+			if (seconds < 1e-6)
+				std::snprintf(buffer, sizeof(buffer), "%.1f ns", seconds * 1e9);
+			else if (seconds < 1e-3)
+				std::snprintf(buffer, sizeof(buffer), "%.2f us", seconds * 1e6);
+			else if (seconds < 1.0)
+				std::snprintf(buffer, sizeof(buffer), "%.2f ms", seconds * 1e3);
+			else
+				std::snprintf(buffer, sizeof(buffer), "%.2f s", seconds);
+
+			return buffer;
+		}
+
+		static std::string formatBytes(uint64_t bytes)
+		{
+			char buffer[32];
+
+			if (bytes >= (1ull << 30))
+				std::snprintf(buffer, sizeof(buffer), "%.2f GiB", bytes / (double)(1ull << 30));
+			else if (bytes >= (1ull << 20))
+				std::snprintf(buffer, sizeof(buffer), "%.2f MiB", bytes / (double)(1ull << 20));
+			else if (bytes >= (1ull << 10))
+				std::snprintf(buffer, sizeof(buffer), "%.2f KiB", bytes / (double)(1ull << 10));
+			else
+				std::snprintf(buffer, sizeof(buffer), "%llu B", (unsigned long long)bytes);
+
+			return buffer;
+		}
+
+		static std::string escapeJson(const std::string& text)
+		{
+			std::string escaped;
+			escaped.reserve(text.size());
+
+			for (char c : text)
+			{
+				if (c == '"' || c == '\\')
+					escaped += '\\';
+
+				escaped += c;
+			}
+
+			return escaped;
+		}
+
+		static std::string formatCount(double value)
+		{
+			char buffer[32];
+
+			if (value >= 1e9)
+				std::snprintf(buffer, sizeof(buffer), "%.2fG", value / 1e9);
+			else if (value >= 1e6)
+				std::snprintf(buffer, sizeof(buffer), "%.2fM", value / 1e6);
+			else if (value >= 1e3)
+				std::snprintf(buffer, sizeof(buffer), "%.2fk", value / 1e3);
+			else
+				std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+
+			return buffer;
+		}
+	}
+
+	BenchmarkState::BenchmarkState(int64_t argument, double minTime)
+		: _argument(argument)
+		, _minTime(minTime)
+	{
+	}
+
+	bool BenchmarkState::keepRunning()
+	{
+		if (!_isStarted)
+		{
+			_isStarted = true;
+
+			// Setup before the loop is not part of the measured memory
+			MemoryTracker::resetPeak();
+			_memoryBaseline = MemoryTracker::getCurrentBytes();
+
+			resumeTiming();
+			return true;
+		}
+
+		_iterations++;
+
+		std::chrono::duration<double> elapsed = _elapsed;
+		if (_isTiming)
+			elapsed += Clock::now() - _start;
+
+		if (elapsed.count() < _minTime && _iterations < Utils::maxBenchmarkIterations)
+			return true;
+
+		pauseTiming();
+
+		uint64_t peak = MemoryTracker::getPeakBytes();
+		_peakMemoryBytes = peak > _memoryBaseline ? peak - _memoryBaseline : 0;
+
+		return false;
+	}
+
+	void BenchmarkState::pauseTiming()
+	{
+		if (!_isTiming)
+			return;
+
+		_elapsed += Clock::now() - _start;
+		_isTiming = false;
+	}
+
+	void BenchmarkState::resumeTiming()
+	{
+		if (_isTiming)
+			return;
+
+		_start = Clock::now();
+		_isTiming = true;
+	}
+
+	void BenchmarkRunner::add(const std::string& name, const std::vector<int64_t>& arguments, const BenchmarkFunction& function)
+	{
+		getBenchmarks().push_back({ name, arguments, function });
+	}
+
+	std::vector<BenchmarkRunner::Benchmark>& BenchmarkRunner::getBenchmarks()
+	{
+		// Registrations run during static initialisation, a function local keeps the order safe
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	int BenchmarkRunner::run(int argc, char** argv)
+	{
+		std::string filter;
+		std::string jsonPath;
+		double minTime = 0.5;
+
+		for (int i = 1; i < argc; i++)
+		{
+			bool hasValue = i + 1 < argc;
+
+			if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+				filter = argv[++i];
+			else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+				minTime = std::atof(argv[++i]);
+			else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+				jsonPath = argv[++i];
+			else
+			{
+				std::fprintf(stderr, "Usage: %s [--filter <text>] [--min-time <seconds>] [--json <path>]\n", argv[0]);
+				return 1;
+			}
+		}
+
+		std::vector<Result> results;
+
+		std::printf("%-48s %12s %12s %14s %12s\n", "Benchmark", "Iterations", "Time", "Items/s", "Peak memory");
+
+		for (const Benchmark& benchmark : getBenchmarks())
+		{
+			std::vector<int64_t> arguments = benchmark.arguments.empty() ? std::vector<int64_t>{ 0 } : benchmark.arguments;
+
+			for (int64_t argument : arguments)
+			{
+				std::string name = benchmark.arguments.empty() ? benchmark.name : benchmark.name + "/" + std::to_string(argument);
+				if (!filter.empty() && name.find(filter) == std::string::npos)
+					continue;
+
+				BenchmarkState state(argument, minTime);
+				benchmark.function(state);
+
+				Result& result = results.emplace_back();
+				result.name = name;
+				result.argument = argument;
+				result.iterations = state.getIterations();
+				result.secondsPerIteration = state.getSeconds() / std::max<uint64_t>(result.iterations, 1);
+				result.itemsPerSecond = result.secondsPerIteration > 0.0 ? state._itemsPerIteration / result.secondsPerIteration : 0.0;
+				result.peakMemoryBytes = state.getPeakMemoryBytes();
+
+				std::printf("%-48s %12llu %12s %14s %12s", name.c_str(), (unsigned long long)result.iterations,
+					Utils::formatDuration(result.secondsPerIteration).c_str(), Utils::formatCount(result.itemsPerSecond).c_str(),
+					Utils::formatBytes(result.peakMemoryBytes).c_str());
+
+				for (const auto& [counterName, counter] : state._counters)
+				{
+					double value = counter.isRate && result.secondsPerIteration > 0.0 ? counter.value / result.secondsPerIteration : counter.value;
+					std::string reportedName = counter.isRate ? counterName + "/s" : counterName;
+
+					std::printf(" %s=%s", reportedName.c_str(), Utils::formatCount(value).c_str());
+					result.counters.emplace_back(reportedName, value);
+				}
+
+				std::printf("\n");
+				std::fflush(stdout);
+			}
+		}
+
+		if (!jsonPath.empty() && !writeJson(jsonPath, results))
+		{
+			std::fprintf(stderr, "Could not write %s\n", jsonPath.c_str());
+			return 1;
+		}
+
+		return 0;
+	}
+
+	bool BenchmarkRunner::writeJson(const std::string& filepath, const std::vector<Result>& results)
+	{
+		std::ofstream out(filepath);
+		if (!out)
+			return false;
+
+		out.precision(17);
+		out << "{\n\t\"benchmarks\": [";
+
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& result = results[i];
+
+			out << (i == 0 ? "\n" : ",\n");
+			out << "\t\t{\n";
+			out << "\t\t\t\"name\": \"" << Utils::escapeJson(result.name) << "\",\n";
+			out << "\t\t\t\"argument\": " << result.argument << ",\n";
+			out << "\t\t\t\"iterations\": " << result.iterations << ",\n";
+			out << "\t\t\t\"secondsPerIteration\": " << result.secondsPerIteration << ",\n";
+			out << "\t\t\t\"itemsPerSecond\": " << result.itemsPerSecond << ",\n";
+			out << "\t\t\t\"peakMemoryBytes\": " << result.peakMemoryBytes << ",\n";
+			out << "\t\t\t\"counters\": {";
+
+			for (size_t j = 0; j < result.counters.size(); j++)
+			{
+				out << (j == 0 ? " " : ", ");
+				out << "\"" << Utils::escapeJson(result.counters[j].first) << "\": " << result.counters[j].second;
+			}
+
+			out << (result.counters.empty() ? "}\n" : " }\n");
+			out << "\t\t}";
+		}
+
+		out << "\n\t]\n}\n";
+		return out.good();
+	}
+}
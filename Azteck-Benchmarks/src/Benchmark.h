@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Azteck
+{
+	// Handed to every benchmark, the timed part runs inside while (state.keepRunning())
+	class BenchmarkState
+	{
+	public:
+		BenchmarkState(int64_t argument, double minTime);
+
+		int64_t getArgument() const { return _argument; }
+
+		bool keepRunning();
+
+		// Setup inside the loop that should not count towards the time
+		void pauseTiming();
+		void resumeTiming();
+
+		// Work done per iteration, reported as a rate
+		void setItemsProcessed(uint64_t items) { _itemsPerIteration = items; }
+		// Extra values per iteration, rates are divided by the time of one iteration
+		void setCounter(const std::string& name, double value, bool isRate = false) { _counters[name] = { value, isRate }; }
+
+		uint64_t getIterations() const { return _iterations; }
+		double getSeconds() const { return _elapsed.count(); }
+		// Highest heap usage above what was allocated when the loop started
+		uint64_t getPeakMemoryBytes() const { return _peakMemoryBytes; }
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Counter
+		{
+			double value = 0.0;
+			bool isRate = false;
+		};
+
+		int64_t _argument;
+		double _minTime;
+
+		uint64_t _iterations = 0;
+		uint64_t _itemsPerIteration = 0;
+		std::map<std::string, Counter> _counters;
+
+		uint64_t _memoryBaseline = 0;
+		uint64_t _peakMemoryBytes = 0;
+
+		bool _isStarted = false;
+		bool _isTiming = false;
+		Clock::time_point _start;
+		std::chrono::duration<double> _elapsed{ 0.0 };
+
+		friend class BenchmarkRunner;
+	};
+
+	using BenchmarkFunction = std::function<void(BenchmarkState&)>;
+
+	class BenchmarkRunner
+	{
+	public:
+		// Every argument becomes its own run, no arguments runs once with 0
+		static void add(const std::string& name, const std::vector<int64_t>& arguments, const BenchmarkFunction& function);
+
+		// Accepts --filter <text>, --min-time <seconds> and --json <path>, returns the process exit code
+		static int run(int argc, char** argv);
+
+	private:
+		struct Result
+		{
+			std::string name;
+			int64_t argument = 0;
+			uint64_t iterations = 0;
+			double secondsPerIteration = 0.0;
+			double itemsPerSecond = 0.0;
+			uint64_t peakMemoryBytes = 0;
+			std::vector<std::pair<std::string, double>> counters;
+		};
+
+		static bool writeJson(const std::string& filepath, const std::vector<Result>& results);
+
+		struct Benchmark
+		{
+			std::string name;
+			std::vector<int64_t> arguments;
+			BenchmarkFunction function;
+		};
+
+		static std::vector<Benchmark>& getBenchmarks();
+	};
+
+	struct BenchmarkRegistration
+	{
+		BenchmarkRegistration(const std::string& name, const std::vector<int64_t>& arguments, const BenchmarkFunction& function)
+		{
+			BenchmarkRunner::add(name, arguments, function);
+		}
+	};
+}
+
+#define AZ_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define AZ_BENCHMARK_CONCAT(a, b) AZ_BENCHMARK_CONCAT_IMPL(a, b)
+
+// Registers a void(BenchmarkState&) function, the variadic part is the list of arguments
+#define AZ_BENCHMARK(function, ...) \
+	static ::Azteck::BenchmarkRegistration AZ_BENCHMARK_CONCAT(benchmarkRegistration, __LINE__)(#function, { __VA_ARGS__ }, function)
@@ -0,0 +1,108 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		static std::atomic<uint64_t> currentBytes = 0;
+		static std::atomic<uint64_t> peakBytes = 0;
+
+		// Keeps the size in front of every block. Global new has to return memory aligned to
+		// the default new alignment, so the header is padded to exactly that
+		static constexpr size_t allocationHeaderSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+		static_assert(allocationHeaderSize >= sizeof(size_t), "Allocation header cannot hold the size");
+
+		static void* trackedAllocate(size_t size)
+		{
+			void* block = std::malloc(size + allocationHeaderSize);
+			if (block == nullptr)
+				return nullptr;
+
+			*static_cast<size_t*>(block) = size;
+
+			uint64_t current = currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+			uint64_t peak = peakBytes.load(std::memory_order_relaxed);
+			while (current > peak && !peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+			{
+			}
+
+			return static_cast<char*>(block) + allocationHeaderSize;
+		}
+
+		static void trackedFree(void* memory)
+		{
+			if (memory == nullptr)
+				return;
+
+			void* block = static_cast<char*>(memory) - allocationHeaderSize;
+			currentBytes.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+
+			std::free(block);
+		}
+	}
+
+	uint64_t MemoryTracker::getCurrentBytes()
+	{
+		return Utils::currentBytes.load(std::memory_order_relaxed);
+	}
+
+	uint64_t MemoryTracker::getPeakBytes()
+	{
+		return Utils::peakBytes.load(std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::resetPeak()
+	{
+		Utils::peakBytes.store(Utils::currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (void* memory = Azteck::Utils::trackedAllocate(size))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Azteck::Utils::trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Azteck::Utils::trackedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	Azteck::Utils::trackedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	Azteck::Utils::trackedFree(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	Azteck::Utils::trackedFree(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	Azteck::Utils::trackedFree(memory);
+}
+
+// Over-aligned types go through the std::align_val_t overloads, which are left to the
+// standard library. Their allocations are not counted
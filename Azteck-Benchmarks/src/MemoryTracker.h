@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Azteck
+{
+	// Counts heap bytes allocated through global new and delete in this executable
+	class MemoryTracker
+	{
+	public:
+		static uint64_t getCurrentBytes();
+		static uint64_t getPeakBytes();
+
+		// Starts a new peak from the current usage
+		static void resetPeak();
+	};
+}
@@ -0,0 +1,201 @@
+#include "Benchmark.h"
+
+#include <Azteck.h>
+
+#include "Platform/Headless/RenderRecorder.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// Renderer2D runs on the headless backend, so these measure the CPU side of the
+// draw path: vertex generation, batching and the uploads it hands to the driver
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		static const OrthographicCamera& getBenchmarkCamera()
+		{
+			static OrthographicCamera camera(-640.0f, 640.0f, -360.0f, 360.0f);
+			return camera;
+		}
+
+		// Spreads primitives over the view so the work does not depend on one transform
+		static glm::mat4 getBenchmarkTransform(int64_t index)
+		{
+			float x = (float)(index % 1280) - 640.0f;
+			float y = (float)((index / 1280) % 720) - 360.0f;
+
+			return glm::translate(glm::mat4(1.0f), { x, y, 0.0f });
+		}
+
+		static void beginRenderStats()
+		{
+			Renderer2D::resetStats();
+			RenderRecorder::reset();
+		}
+
+		// Draw calls and uploads per iteration, identical from run to run
+		static void reportRenderStats(BenchmarkState& state)
+		{
+			double iterations = (double)std::max<uint64_t>(state.getIterations(), 1);
+			const RenderRecorder::Statistics& stats = RenderRecorder::getStatistics();
+
+			state.setCounter("drawCalls", stats.drawCalls / iterations);
+			state.setCounter("bytesUploaded", stats.getTotalBytesUploaded() / iterations);
+		}
+	}
+
+	static void Renderer2D_DrawQuad(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+		glm::vec4 color{ 0.8f, 0.2f, 0.3f, 1.0f };
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+
+			for (int64_t i = 0; i < count; i++)
+				Renderer2D::drawQuad(Utils::getBenchmarkTransform(i), color);
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(count);
+		state.setCounter("vertices", count * 4.0, true);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_DrawQuad, 1000, 10000, 100000, 1000000);
+
+	// More textures than slots, every slot overflow forces a flush
+	static void Renderer2D_DrawTexturedQuad(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+
+		std::vector<Ref<Texture2D>> textures(64);
+		for (Ref<Texture2D>& texture : textures)
+			texture = Texture2D::create(TextureSpecification{});
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+
+			for (int64_t i = 0; i < count; i++)
+				Renderer2D::drawQuad(Utils::getBenchmarkTransform(i), textures[i % textures.size()]);
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(count);
+		state.setCounter("vertices", count * 4.0, true);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_DrawTexturedQuad, 1000, 10000, 100000, 1000000);
+
+	static void Renderer2D_DrawCircle(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+		glm::vec4 color{ 0.2f, 0.8f, 0.3f, 1.0f };
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+
+			for (int64_t i = 0; i < count; i++)
+				Renderer2D::drawCircle(Utils::getBenchmarkTransform(i), color, 1.0f, 0.005f);
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(count);
+		state.setCounter("vertices", count * 4.0, true);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_DrawCircle, 1000, 10000, 100000, 1000000);
+
+	static void Renderer2D_DrawLine(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+		glm::vec4 color{ 0.2f, 0.3f, 0.8f, 1.0f };
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+
+			for (int64_t i = 0; i < count; i++)
+			{
+				glm::vec3 start(Utils::getBenchmarkTransform(i)[3]);
+				Renderer2D::drawLine(start, start + glm::vec3(8.0f, 8.0f, 0.0f), color);
+			}
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(count);
+		state.setCounter("vertices", count * 2.0, true);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_DrawLine, 1000, 10000, 100000, 1000000);
+
+	// The argument is the number of glyphs, drawn as strings of 64 characters
+	static void Renderer2D_DrawString(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+
+		const std::string text = "The quick brown fox jumps over the lazy dog 0123456789 ABCDEFGHI";
+		int64_t stringCount = std::max<int64_t>(count / (int64_t)text.size(), 1);
+
+		Ref<Font> font = Font::getDefault();
+		Renderer2D::TextParams params;
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+
+			for (int64_t i = 0; i < stringCount; i++)
+				Renderer2D::drawString(text, font, Utils::getBenchmarkTransform(i), params);
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(stringCount * text.size());
+		state.setCounter("vertices", stringCount * text.size() * 4.0, true);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_DrawString, 1000, 10000, 100000, 1000000);
+
+	// Only the flush is timed, the batch is filled with the timer paused
+	static void Renderer2D_FlushBatch(BenchmarkState& state)
+	{
+		int64_t count = state.getArgument();
+		glm::vec4 color{ 0.8f, 0.2f, 0.3f, 1.0f };
+
+		Utils::beginRenderStats();
+
+		while (state.keepRunning())
+		{
+			state.pauseTiming();
+
+			Renderer2D::beginScene(Utils::getBenchmarkCamera());
+			for (int64_t i = 0; i < count; i++)
+				Renderer2D::drawQuad(Utils::getBenchmarkTransform(i), color);
+
+			state.resumeTiming();
+
+			Renderer2D::endScene();
+		}
+
+		state.setItemsProcessed(count);
+		Utils::reportRenderStats(state);
+	}
+	AZ_BENCHMARK(Renderer2D_FlushBatch, 1000, 5000, 9999);
+}
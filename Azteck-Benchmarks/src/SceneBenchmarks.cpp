@@ -0,0 +1,236 @@
+#include "Benchmark.h"
+
+#include <Azteck.h>
+
+#include "Azteck/Scene/SceneSerializer.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Azteck
+{
+	// Fraction of the entities that get each component, add a row to benchmark another mix
+	struct SyntheticSceneSpec
+	{
+		const char* name;
+
+		float spriteRatio = 0.0f;
+		float circleRatio = 0.0f;
+		float physicsRatio = 0.0f;
+		float textRatio = 0.0f;
+		// Parented to an earlier entity instead of being a root
+		float childRatio = 0.0f;
+	};
+
+	namespace Utils
+	{
+		static const SyntheticSceneSpec sceneMixes[] =
+		{
+			{ "Sprites", 1.0f, 0.0f, 0.0f, 0.0f, 0.0f },
+			{ "Physics", 0.0f, 0.0f, 1.0f, 0.0f, 0.0f },
+			{ "Mixed",   0.6f, 0.2f, 0.2f, 0.05f, 0.25f },
+		};
+
+		static const std::vector<int64_t> sceneSizes = { 1000, 10000, 100000 };
+
+		static std::string getEntityName(int64_t index)
+		{
+			return "Entity " + std::to_string(index);
+		}
+
+		// Same seed every time, so runs of the same spec build the same scene
+		static Ref<Scene> generateScene(const SyntheticSceneSpec& spec, int64_t entityCount)
+		{
+			Ref<Scene> scene = createRef<Scene>();
+
+			std::mt19937 random(1234);
+			std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+			std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+			Entity camera = scene->createEntity("Camera");
+			camera.addComponent<CameraComponent>();
+
+			std::vector<Entity> entities;
+			entities.reserve(entityCount);
+
+			for (int64_t i = 0; i < entityCount; i++)
+			{
+				Entity entity = scene->createEntity(getEntityName(i));
+				entity.getComponent<TransformComponent>().translation = { position(random), position(random), 0.0f };
+
+				if (chance(random) < spec.spriteRatio)
+					entity.addComponent<SpriteRendererComponent>(glm::vec4{ chance(random), chance(random), chance(random), 1.0f });
+
+				if (chance(random) < spec.circleRatio)
+					entity.addComponent<CircleRendererComponent>();
+
+				if (chance(random) < spec.physicsRatio)
+				{
+					entity.addComponent<Rigidbody2DComponent>().type = Rigidbody2DComponent::BodyType::Dynamic;
+					entity.addComponent<BoxCollider2DComponent>();
+				}
+
+				if (chance(random) < spec.textRatio)
+					entity.addComponent<TextComponent>().textString = getEntityName(i);
+
+				if (!entities.empty() && chance(random) < spec.childRatio)
+				{
+					std::uniform_int_distribution<size_t> parentIndex(0, entities.size() - 1);
+					scene->setParent(entity, entities[parentIndex(random)]);
+				}
+
+				entities.push_back(entity);
+			}
+
+			scene->onViewportResize(1280, 720);
+			return scene;
+		}
+
+		static std::filesystem::path getBenchmarkScenePath()
+		{
+			return std::filesystem::temp_directory_path() / "AzteckBenchmarkScene.yaml";
+		}
+	}
+
+	static void Scene_Copy(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		Ref<Scene> scene = Utils::generateScene(spec, state.getArgument());
+
+		while (state.keepRunning())
+		{
+			Ref<Scene> copy = Scene::copy(scene);
+
+			// Tearing the copy down is not part of copying
+			state.pauseTiming();
+			copy = nullptr;
+			state.resumeTiming();
+		}
+
+		state.setItemsProcessed(state.getArgument());
+	}
+
+	static void Scene_Serialize(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		Ref<Scene> scene = Utils::generateScene(spec, state.getArgument());
+		std::string filepath = Utils::getBenchmarkScenePath().string();
+
+		SceneSerializer serializer(scene);
+		while (state.keepRunning())
+			serializer.serialize(filepath);
+
+		state.setItemsProcessed(state.getArgument());
+		state.setCounter("fileBytes", (double)std::filesystem::file_size(filepath));
+	}
+
+	static void Scene_Deserialize(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		std::string filepath = Utils::getBenchmarkScenePath().string();
+		{
+			SceneSerializer serializer(Utils::generateScene(spec, state.getArgument()));
+			serializer.serialize(filepath);
+		}
+
+		while (state.keepRunning())
+		{
+			Ref<Scene> scene = createRef<Scene>();
+			SceneSerializer serializer(scene);
+			serializer.deserialize(filepath);
+
+			state.pauseTiming();
+			scene = nullptr;
+			state.resumeTiming();
+		}
+
+		state.setItemsProcessed(state.getArgument());
+	}
+
+	// A physics step, the sync back into transforms and the world transform update,
+	// renderers in the mix are not drawn
+	static void Scene_UpdatePhysics(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		Ref<Scene> scene = Utils::generateScene(spec, state.getArgument());
+
+		scene->onSimulationStart();
+
+		const Timestep timestep = scene->getPhysics2DSettings().fixedTimestep;
+		while (state.keepRunning())
+			scene->stepPhysics(timestep);
+
+		scene->onSimulationStop();
+
+		state.setItemsProcessed(state.getArgument());
+	}
+
+	// Looks up every entity once, in an order unrelated to creation
+	static void Scene_GetEntityByUUID(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		Ref<Scene> scene = Utils::generateScene(spec, state.getArgument());
+
+		std::vector<UUID> ids;
+		auto view = scene->getAllEntitiesWith<IDComponent>();
+		for (auto entity : view)
+			ids.push_back(view.get<IDComponent>(entity).id);
+
+		std::shuffle(ids.begin(), ids.end(), std::mt19937(1234));
+
+		uint64_t found = 0;
+		while (state.keepRunning())
+		{
+			for (UUID id : ids)
+				found += (bool)scene->getEntityByUUID(id);
+		}
+
+		state.setItemsProcessed(ids.size());
+		state.setCounter("found", (double)found / std::max<uint64_t>(state.getIterations(), 1));
+	}
+
+	static void Scene_GetEntityByName(BenchmarkState& state, const SyntheticSceneSpec& spec)
+	{
+		Ref<Scene> scene = Utils::generateScene(spec, state.getArgument());
+
+		std::vector<std::string> names;
+		for (int64_t i = 0; i < state.getArgument(); i++)
+			names.push_back(Utils::getEntityName(i));
+
+		std::shuffle(names.begin(), names.end(), std::mt19937(1234));
+
+		uint64_t found = 0;
+		while (state.keepRunning())
+		{
+			for (const std::string& name : names)
+				found += (bool)scene->getEntityByName(name);
+		}
+
+		state.setItemsProcessed(names.size());
+		state.setCounter("found", (double)found / std::max<uint64_t>(state.getIterations(), 1));
+	}
+
+	static bool registerSceneBenchmarks()
+	{
+		using SceneBenchmark = void(*)(BenchmarkState&, const SyntheticSceneSpec&);
+
+		auto add = [](const char* name, SceneBenchmark benchmark, const SyntheticSceneSpec& spec)
+		{
+			BenchmarkRunner::add(std::string(name) + "/" + spec.name, Utils::sceneSizes,
+				[benchmark, spec](BenchmarkState& state) { benchmark(state, spec); });
+		};
+
+		for (const SyntheticSceneSpec& spec : Utils::sceneMixes)
+		{
+			add("Scene_Copy", Scene_Copy, spec);
+			add("Scene_Serialize", Scene_Serialize, spec);
+			add("Scene_Deserialize", Scene_Deserialize, spec);
+
+			if (spec.physicsRatio > 0.0f)
+				add("Scene_UpdatePhysics", Scene_UpdatePhysics, spec);
+		}
+
+		// Lookups only depend on the entity count
+		add("Scene_GetEntityByUUID", Scene_GetEntityByUUID, Utils::sceneMixes[0]);
+		add("Scene_GetEntityByName", Scene_GetEntityByName, Utils::sceneMixes[0]);
+
+		return true;
+	}
+
+	static bool sceneBenchmarksRegistered = registerSceneBenchmarks();
+}
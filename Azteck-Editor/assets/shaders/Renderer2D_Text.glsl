@@ -6,7 +6,8 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
-layout(location = 3) in int a_EntityID;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in int a_EntityID;
 
 layout(std140, binding = 0) uniform Camera
 {
@@ -20,12 +21,14 @@ struct VertexOutput
 };
 
 layout (location = 0) out VertexOutput Output;
-layout (location = 2) out flat int v_EntityID;
+layout (location = 2) out flat float v_TexIndex;
+layout (location = 3) out flat int v_EntityID;
 
 void main()
 {
 	Output.Color = a_Color;
 	Output.TexCoord = a_TexCoord;
+	v_TexIndex = a_TexIndex;
 	v_EntityID = a_EntityID;
 
 	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
@@ -44,13 +47,96 @@ struct VertexOutput
 };
 
 layout (location = 0) in VertexOutput Input;
-layout (location = 2) in flat int v_EntityID;
+layout (location = 2) in flat float v_TexIndex;
+layout (location = 3) in flat int v_EntityID;
 
-layout (binding = 0) uniform sampler2D u_FontAtlas;
+layout (binding = 0) uniform sampler2D u_FontAtlases[32];
+
+vec4 sampleFontAtlas(vec2 texCoord)
+{
+	switch (int(v_TexIndex))
+	{
+		case  0: return texture(u_FontAtlases[0], texCoord);
+		case  1: return texture(u_FontAtlases[1], texCoord);
+		case  2: return texture(u_FontAtlases[2], texCoord);
+		case  3: return texture(u_FontAtlases[3], texCoord);
+		case  4: return texture(u_FontAtlases[4], texCoord);
+		case  5: return texture(u_FontAtlases[5], texCoord);
+		case  6: return texture(u_FontAtlases[6], texCoord);
+		case  7: return texture(u_FontAtlases[7], texCoord);
+		case  8: return texture(u_FontAtlases[8], texCoord);
+		case  9: return texture(u_FontAtlases[9], texCoord);
+		case 10: return texture(u_FontAtlases[10], texCoord);
+		case 11: return texture(u_FontAtlases[11], texCoord);
+		case 12: return texture(u_FontAtlases[12], texCoord);
+		case 13: return texture(u_FontAtlases[13], texCoord);
+		case 14: return texture(u_FontAtlases[14], texCoord);
+		case 15: return texture(u_FontAtlases[15], texCoord);
+		case 16: return texture(u_FontAtlases[16], texCoord);
+		case 17: return texture(u_FontAtlases[17], texCoord);
+		case 18: return texture(u_FontAtlases[18], texCoord);
+		case 19: return texture(u_FontAtlases[19], texCoord);
+		case 20: return texture(u_FontAtlases[20], texCoord);
+		case 21: return texture(u_FontAtlases[21], texCoord);
+		case 22: return texture(u_FontAtlases[22], texCoord);
+		case 23: return texture(u_FontAtlases[23], texCoord);
+		case 24: return texture(u_FontAtlases[24], texCoord);
+		case 25: return texture(u_FontAtlases[25], texCoord);
+		case 26: return texture(u_FontAtlases[26], texCoord);
+		case 27: return texture(u_FontAtlases[27], texCoord);
+		case 28: return texture(u_FontAtlases[28], texCoord);
+		case 29: return texture(u_FontAtlases[29], texCoord);
+		case 30: return texture(u_FontAtlases[30], texCoord);
+		case 31: return texture(u_FontAtlases[31], texCoord);
+	}
+
+	return vec4(0.0);
+}
+
+ivec2 fontAtlasSize()
+{
+	switch (int(v_TexIndex))
+	{
+		case  0: return textureSize(u_FontAtlases[0], 0);
+		case  1: return textureSize(u_FontAtlases[1], 0);
+		case  2: return textureSize(u_FontAtlases[2], 0);
+		case  3: return textureSize(u_FontAtlases[3], 0);
+		case  4: return textureSize(u_FontAtlases[4], 0);
+		case  5: return textureSize(u_FontAtlases[5], 0);
+		case  6: return textureSize(u_FontAtlases[6], 0);
+		case  7: return textureSize(u_FontAtlases[7], 0);
+		case  8: return textureSize(u_FontAtlases[8], 0);
+		case  9: return textureSize(u_FontAtlases[9], 0);
+		case 10: return textureSize(u_FontAtlases[10], 0);
+		case 11: return textureSize(u_FontAtlases[11], 0);
+		case 12: return textureSize(u_FontAtlases[12], 0);
+		case 13: return textureSize(u_FontAtlases[13], 0);
+		case 14: return textureSize(u_FontAtlases[14], 0);
+		case 15: return textureSize(u_FontAtlases[15], 0);
+		case 16: return textureSize(u_FontAtlases[16], 0);
+		case 17: return textureSize(u_FontAtlases[17], 0);
+		case 18: return textureSize(u_FontAtlases[18], 0);
+		case 19: return textureSize(u_FontAtlases[19], 0);
+		case 20: return textureSize(u_FontAtlases[20], 0);
+		case 21: return textureSize(u_FontAtlases[21], 0);
+		case 22: return textureSize(u_FontAtlases[22], 0);
+		case 23: return textureSize(u_FontAtlases[23], 0);
+		case 24: return textureSize(u_FontAtlases[24], 0);
+		case 25: return textureSize(u_FontAtlases[25], 0);
+		case 26: return textureSize(u_FontAtlases[26], 0);
+		case 27: return textureSize(u_FontAtlases[27], 0);
+		case 28: return textureSize(u_FontAtlases[28], 0);
+		case 29: return textureSize(u_FontAtlases[29], 0);
+		case 30: return textureSize(u_FontAtlases[30], 0);
+		case 31: return textureSize(u_FontAtlases[31], 0);
+	}
+
+	return ivec2(1);
+}
 
 float screenPxRange() {
 	const float pxRange = 2.0; // set to distance field's pixel range
-    vec2 unitRange = vec2(pxRange)/vec2(textureSize(u_FontAtlas, 0));
+    vec2 unitRange = vec2(pxRange)/vec2(fontAtlasSize());
     vec2 screenTexSize = vec2(1.0)/fwidth(Input.TexCoord);
     return max(0.5*dot(unitRange, screenTexSize), 1.0);
 }
@@ -61,9 +147,7 @@ float median(float r, float g, float b) {
 
 void main()
 {
-	vec4 texColor = Input.Color * texture(u_FontAtlas, Input.TexCoord);
-
-	vec3 msd = texture(u_FontAtlas, Input.TexCoord).rgb;
+	vec3 msd = sampleFontAtlas(Input.TexCoord).rgb;
     float sd = median(msd.r, msd.g, msd.b);
     float screenPxDistance = screenPxRange()*(sd - 0.5);
     float opacity = clamp(screenPxDistance + 0.5, 0.0, 1.0);
@@ -76,4 +160,4 @@ void main()
 		discard;
 
 	o_EntityID = v_EntityID;
-}
+}
\ No newline at end of file
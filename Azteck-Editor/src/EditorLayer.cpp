@@ -84,6 +84,10 @@ namespace Azteck
 			_editorCamera.setViewportSize(_viewportSize.x, _viewportSize.y);
 		}
 
+		// Thumbnails render into their own framebuffer, before the viewport stats start counting
+		if (_contentBrowserPanel)
+			_contentBrowserPanel->onUpdate();
+
 		Renderer2D::resetStats();
 		_frameBuffer->bind();
 		RenderCommand::setClearColor(glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
@@ -287,7 +291,7 @@ namespace Azteck
 			if (!camera)
 				return;
 
-			Renderer2D::beginScene(camera.getComponent<CameraComponent>().camera, camera.getComponent<TransformComponent>().getTransform());
+			Renderer2D::beginScene(camera.getComponent<CameraComponent>().camera, _activeScene->getWorldTransform(camera));
 		}
 		else
 		{
@@ -681,7 +685,7 @@ namespace Azteck
 			glm::mat4 cameraView = _editorCamera.getViewMatrix();
 
 			auto& transformComponent = selectedEntity.getComponent<TransformComponent>();
-			glm::mat4 transform = transformComponent.getTransform();
+			glm::mat4 transform = _activeScene->getWorldTransform(selectedEntity);
 
 			// Snapping
 			bool snap = Input::isKeyPressed(Key::LeftControl);
@@ -698,6 +702,10 @@ namespace Azteck
 
 			if (ImGuizmo::IsUsing())
 			{
+				// The gizmo works in world space, the component is relative to the parent
+				if (Entity parent = _activeScene->getParent(selectedEntity))
+					transform = glm::inverse(_activeScene->getWorldTransform(parent)) * transform;
+
 				glm::vec3 translation;
 				glm::vec3 rotation;
 				glm::vec3 scale;
@@ -706,6 +714,8 @@ namespace Azteck
 					transformComponent.translation = translation;
 					transformComponent.rotation = rotation;
 					transformComponent.scale = scale;
+
+					_activeScene->markTransformDirty(selectedEntity);
 				}
 
 			}
@@ -757,9 +767,7 @@ namespace Azteck
 	void EditorLayer::renderSelectedEntityOutline()
 	{
 		if (Entity selectedEntity = _sceneHierarchyPanel.getSelectedEntity()) {
-			const TransformComponent& transform = selectedEntity.getComponent<TransformComponent>();
-
-			Renderer2D::drawRect(transform.getTransform(), glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
+			Renderer2D::drawRect(_activeScene->getWorldTransform(selectedEntity), glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
 		}
 	}
 
@@ -774,14 +782,38 @@ namespace Azteck
 		int mouseX = static_cast<int>(mx);
 		int mouseY = static_cast<int>(my);
 
-		Entity entity{};
+		if (mouseX < 0 || mouseY < 0 || mouseX >= static_cast<int>(_viewportSize.x) || mouseY >= static_cast<int>(_viewportSize.y))
+			return {};
+
+		// The entity ID comes back a frame or two late instead of stalling on the GPU
+		_frameBuffer->readPixelAsync(1, mouseX, mouseY);
+
+		int pixelData;
+		if (_frameBuffer->getAsyncPixel(pixelData))
+		{
+			// The scene may have changed since the read was queued
+			entt::entity handle = static_cast<entt::entity>(pixelData);
+			if (pixelData == -1 || !_activeScene->isEntityValid(handle))
+				return {};
+
+			return Entity(handle, _activeScene.get());
+		}
 
-		if (mouseX >= 0 && mouseY >= 0 && mouseX < static_cast<int>(_viewportSize.x) && mouseY < static_cast<int>(_viewportSize.y))
+		// Nothing has come back yet, pick on the CPU instead
+		glm::mat4 viewProjection = _editorCamera.getViewProjection();
+		if (_sceneState == SceneState::Play)
 		{
-			int pixelData = _frameBuffer->readPixel(1, mouseX, mouseY);
-			entity = pixelData == -1 ? Entity() : Entity(static_cast<entt::entity>(pixelData), _activeScene.get());
+			Entity cameraEntity = _activeScene->getPrimaryCamera();
+			if (!cameraEntity)
+				return {};
+
+			viewProjection = cameraEntity.getComponent<CameraComponent>().camera.getProjection()
+				* glm::inverse(_activeScene->getWorldTransform(cameraEntity));
 		}
 
-		return entity;
+		glm::vec4 ndc = { mx / _viewportSize.x * 2.0f - 1.0f, my / _viewportSize.y * 2.0f - 1.0f, 0.0f, 1.0f };
+		glm::vec4 worldPosition = glm::inverse(viewProjection) * ndc;
+
+		return _activeScene->pickEntity2D(glm::vec2(worldPosition) / worldPosition.w);
 	}
 }
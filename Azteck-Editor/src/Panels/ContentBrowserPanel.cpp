@@ -5,24 +5,81 @@
 
 #include <imgui/imgui.h>
 
+#include "FileWatch.h"
+
 namespace Azteck {
 	ContentBrowserPanel::ContentBrowserPanel()
 	{
 		_baseDirectory = Project::getAssetDirectory();
-		_currentDirectory = _baseDirectory;
 		_directoryIcon = Texture2D::create("resources/icons/ContentBrowser/DirectoryIcon.png");
 		_fileIcon = Texture2D::create("resources/icons/ContentBrowser/FileIcon.png");
+		_thumbnailCache = createScope<ThumbnailCache>();
+
+		setCurrentDirectory(_baseDirectory);
+	}
+
+	ContentBrowserPanel::~ContentBrowserPanel()
+	{
+		_directoryWatcher.reset();
+	}
+
+	void ContentBrowserPanel::setCurrentDirectory(const std::filesystem::path& directory)
+	{
+		_currentDirectory = directory;
+		_entriesDirty = true;
+
+		// Changes are reported from the watcher thread, the listing is refreshed on the next draw
+		_directoryWatcher.reset();
+		_directoryWatcher = createScope<filewatch::FileWatch<std::string>>(_currentDirectory.string(), [this](const std::string&, const filewatch::Event)
+			{
+				_entriesDirty = true;
+			});
+	}
+
+	void ContentBrowserPanel::refreshEntries()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		_entriesDirty = false;
+		_entries.clear();
+
+		std::error_code error;
+		for (auto& directoryEntry : std::filesystem::directory_iterator(_currentDirectory, error))
+		{
+			const auto& path = directoryEntry.path();
+			_entries.push_back({ path, path.filename().string(), directoryEntry.is_directory(error), directoryEntry.last_write_time(error) });
+		}
+
+		if (error)
+			AZ_CORE_WARN("Failed to list directory {0}: {1}", _currentDirectory.string(), error.message());
+
+		std::sort(_entries.begin(), _entries.end(), [](const DirectoryEntry& a, const DirectoryEntry& b)
+			{
+				if (a.isDirectory != b.isDirectory)
+					return a.isDirectory;
+				return a.filename < b.filename;
+			});
+	}
+
+	void ContentBrowserPanel::onUpdate()
+	{
+		_thumbnailCache->renderPendingPreviews();
 	}
 
 	void ContentBrowserPanel::onImGuiRender()
 	{
 		ImGui::Begin("Content Browser");
 
+		if (_entriesDirty)
+			refreshEntries();
+
+		_thumbnailCache->update();
+
 		if (_currentDirectory != _baseDirectory)
 		{
 			if (ImGui::Button("<-"))
 			{
-				_currentDirectory = _currentDirectory.parent_path();
+				setCurrentDirectory(_currentDirectory.parent_path());
 			}
 		}
 
@@ -35,41 +92,65 @@ namespace Azteck {
 		if (columnCount < 1)
 			columnCount = 1;
 
-		ImGui::Columns(columnCount, 0, false);
+		std::filesystem::path nextDirectory;
 
-		for (auto& directoryEntry : std::filesystem::directory_iterator(_currentDirectory))
+		if (ImGui::BeginTable("ContentBrowserTable", columnCount))
 		{
-			const auto& path = directoryEntry.path();
-			std::string filenameString = path.filename().string();
-
-			ImGui::PushID(filenameString.c_str());
-			Ref<Texture2D> icon = directoryEntry.is_directory() ? _directoryIcon : _fileIcon;
-
-			ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
-			ImGui::ImageButton((ImTextureID)icon->getRendererID(), { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
-
-			if (ImGui::BeginDragDropSource())
-			{
-				const wchar_t* itemPath = path.c_str();
-				ImGui::SetDragDropPayload("CONTENT_BROWSER_ITEM", itemPath, (wcslen(itemPath) + 1) * sizeof(wchar_t));
-				ImGui::EndDragDropSource();
-			}
+			// Only the rows in view are laid out
+			const int rowCount = ((int)_entries.size() + columnCount - 1) / columnCount;
 
-			ImGui::PopStyleColor();
-
-			if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+			ImGuiListClipper clipper;
+			clipper.Begin(rowCount);
+			while (clipper.Step())
 			{
-				if (directoryEntry.is_directory())
-					_currentDirectory /= path.filename();
-
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+				{
+					ImGui::TableNextRow();
+
+					const size_t rowEnd = std::min(_entries.size(), (size_t)(row + 1) * columnCount);
+					for (size_t i = (size_t)row * columnCount; i < rowEnd; i++)
+					{
+						const DirectoryEntry& entry = _entries[i];
+						ImGui::TableNextColumn();
+
+						ImGui::PushID(entry.filename.c_str());
+						Ref<Texture2D> icon = _directoryIcon;
+						if (!entry.isDirectory)
+						{
+							Ref<Texture2D> thumbnail = _thumbnailCache->getThumbnail(entry.path, entry.lastWriteTime);
+							icon = thumbnail ? thumbnail : _fileIcon;
+						}
+
+						ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
+						ImGui::ImageButton((ImTextureID)icon->getRendererID(), { thumbnailSize, thumbnailSize }, { 0, 1 }, { 1, 0 });
+
+						if (ImGui::BeginDragDropSource())
+						{
+							const wchar_t* itemPath = entry.path.c_str();
+							ImGui::SetDragDropPayload("CONTENT_BROWSER_ITEM", itemPath, (wcslen(itemPath) + 1) * sizeof(wchar_t));
+							ImGui::EndDragDropSource();
+						}
+
+						ImGui::PopStyleColor();
+
+						if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+						{
+							if (entry.isDirectory)
+								nextDirectory = entry.path;
+						}
+						ImGui::TextWrapped(entry.filename.c_str());
+
+						ImGui::PopID();
+					}
+				}
 			}
-			ImGui::TextWrapped(filenameString.c_str());
 
-			ImGui::NextColumn();
-			ImGui::PopID();
+			ImGui::EndTable();
 		}
 
-		ImGui::Columns(1);
+		// Entries are still referenced while drawing, so the switch waits until the table is done
+		if (!nextDirectory.empty())
+			setCurrentDirectory(nextDirectory);
 
 		//ImGui::SliderFloat("Thumbnail Size", &thumbnailSize, 16, 512);
 		//ImGui::SliderFloat("Padding", &padding, 0, 32);
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "Azteck/Renderer/Texture.h"
+#include "ThumbnailCache.h"
+
+#include <atomic>
+
+namespace filewatch
+{
+	template<typename T>
+	class FileWatch;
+}
 
 namespace Azteck
 {
@@ -8,14 +17,35 @@ namespace Azteck
 	{
 	public:
 		ContentBrowserPanel();
+		~ContentBrowserPanel();
 
+		// Off-screen work that must not land in the viewport pass
+		void onUpdate();
 		void onImGuiRender();
 
+	private:
+		struct DirectoryEntry
+		{
+			std::filesystem::path path;
+			std::string filename;
+			bool isDirectory;
+			std::filesystem::file_time_type lastWriteTime;
+		};
+
+		void setCurrentDirectory(const std::filesystem::path& directory);
+		void refreshEntries();
+
 	private:
 		std::filesystem::path _currentDirectory;
 		std::filesystem::path _baseDirectory;
 
 		Ref<Texture2D> _directoryIcon;
 		Ref<Texture2D> _fileIcon;
+		Scope<ThumbnailCache> _thumbnailCache;
+
+		// Listing of the current directory, only read again when the watcher reports a change
+		std::vector<DirectoryEntry> _entries;
+		std::atomic<bool> _entriesDirty = true;
+		Scope<filewatch::FileWatch<std::string>> _directoryWatcher;
 	};
 }
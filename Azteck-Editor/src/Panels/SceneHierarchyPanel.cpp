@@ -17,21 +17,293 @@ namespace Azteck
 		setContext(context);
 	}
 
+	SceneHierarchyPanel::~SceneHierarchyPanel()
+	{
+		disconnectSignals();
+	}
+
 	void SceneHierarchyPanel::setContext(const Ref<Scene>& context)
 	{
+		disconnectSignals();
+
 		_context = context;
 		_selectedEntity = {};
+		_rowsDirty = true;
+
+		connectSignals();
+		rebuildEntityList();
+	}
+
+	void SceneHierarchyPanel::connectSignals()
+	{
+		if (!_context)
+			return;
+
+		// Every entity gets an IDComponent on creation
+		_context->_registry.on_construct<IDComponent>().connect<&SceneHierarchyPanel::onEntityCreated>(*this);
+		_context->_registry.on_destroy<IDComponent>().connect<&SceneHierarchyPanel::onEntityDestroyed>(*this);
+		_context->_registry.on_update<TagComponent>().connect<&SceneHierarchyPanel::onTagChanged>(*this);
+	}
+
+	void SceneHierarchyPanel::disconnectSignals()
+	{
+		if (!_context)
+			return;
+
+		_context->_registry.on_construct<IDComponent>().disconnect<&SceneHierarchyPanel::onEntityCreated>(*this);
+		_context->_registry.on_destroy<IDComponent>().disconnect<&SceneHierarchyPanel::onEntityDestroyed>(*this);
+		_context->_registry.on_update<TagComponent>().disconnect<&SceneHierarchyPanel::onTagChanged>(*this);
+	}
+
+	void SceneHierarchyPanel::onEntityCreated(entt::registry& registry, entt::entity entity)
+	{
+		_entityListIndex[entity] = _entityList.size();
+		_entityList.push_back(entity);
+
+		_searchIndexDirty = true;
+	}
+
+	void SceneHierarchyPanel::onEntityDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		auto it = _entityListIndex.find(entity);
+		if (it == _entityListIndex.end())
+			return;
+
+		_entityList[it->second] = entt::null;
+		_entityListIndex.erase(it);
+		_entityListHasHoles = true;
+
+		_searchIndexDirty = true;
+	}
+
+	void SceneHierarchyPanel::onTagChanged(entt::registry& registry, entt::entity entity)
+	{
+		_searchIndexDirty = true;
+	}
+
+	void SceneHierarchyPanel::rebuildEntityList()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		_entityList.clear();
+		_entityListIndex.clear();
+		_entityListHasHoles = false;
+		_searchIndexDirty = true;
+
+		if (!_context)
+			return;
+
+		// Storages iterate newest first
+		auto view = _context->_registry.view<IDComponent>();
+		_entityList.assign(view.begin(), view.end());
+		std::reverse(_entityList.begin(), _entityList.end());
+
+		for (size_t i = 0; i < _entityList.size(); i++)
+			_entityListIndex[_entityList[i]] = i;
+	}
+
+	void SceneHierarchyPanel::compactEntityList()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		_entityList.erase(std::remove(_entityList.begin(), _entityList.end(), entt::entity(entt::null)), _entityList.end());
+		for (size_t i = 0; i < _entityList.size(); i++)
+			_entityListIndex[_entityList[i]] = i;
+
+		_entityListHasHoles = false;
+	}
+
+	static std::string toLower(const std::string& string)
+	{
+		std::string result = string;
+		std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return result;
+	}
+
+	// Up to three characters packed with their count, so "a" and "a\0" stay apart
+	static uint32_t searchGramKey(const char* characters, size_t count)
+	{
+		uint32_t key = (uint32_t)count << 24;
+		for (size_t i = 0; i < count; i++)
+			key |= (uint32_t)(unsigned char)characters[i] << (i * 8);
+
+		return key;
+	}
+
+	void SceneHierarchyPanel::updateFilter()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (_searchIndexDirty)
+		{
+			_searchIndex.clear();
+			_searchIndex.reserve(_entityList.size());
+			_searchGrams.clear();
+
+			for (entt::entity entity : _entityList)
+			{
+				uint32_t slot = (uint32_t)_searchIndex.size();
+				const std::string& name = _searchIndex.emplace_back(entity, toLower(_context->_registry.get<TagComponent>(entity).tag)).second;
+
+				for (size_t length = 1; length <= 3; length++)
+				{
+					for (size_t i = 0; i + length <= name.size(); i++)
+					{
+						std::vector<uint32_t>& slots = _searchGrams[searchGramKey(name.data() + i, length)];
+						if (slots.empty() || slots.back() != slot)
+							slots.push_back(slot);
+					}
+				}
+			}
+
+			_searchIndexDirty = false;
+			_filterDirty = true;
+		}
+
+		if (!_filterDirty)
+			return;
+
+		_filteredEntities.clear();
+		_filterDirty = false;
+
+		// Every match contains all grams of the filter, so the rarest one bounds the candidates
+		const size_t gramLength = std::min<size_t>(_activeFilter.size(), 3);
+		const std::vector<uint32_t>* candidates = nullptr;
+
+		for (size_t i = 0; i + gramLength <= _activeFilter.size(); i++)
+		{
+			auto it = _searchGrams.find(searchGramKey(_activeFilter.data() + i, gramLength));
+			if (it == _searchGrams.end())
+				return;
+
+			if (!candidates || it->second.size() < candidates->size())
+				candidates = &it->second;
+		}
+
+		if (!candidates)
+			return;
+
+		for (uint32_t slot : *candidates)
+		{
+			const auto& [entity, name] = _searchIndex[slot];
+			if (gramLength == _activeFilter.size() || name.find(_activeFilter) != std::string::npos)
+				_filteredEntities.push_back(entity);
+		}
+	}
+
+	void SceneHierarchyPanel::rebuildRows()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		_rows.clear();
+
+		// Depth first, children are pushed in reverse so they come out in order
+		std::vector<std::pair<entt::entity, uint32_t>> stack;
+		for (auto it = _entityList.rbegin(); it != _entityList.rend(); ++it)
+		{
+			if (*it != entt::null && !_context->getParent({ *it, _context.get() }))
+				stack.emplace_back(*it, 0);
+		}
+
+		while (!stack.empty())
+		{
+			auto [entity, depth] = stack.back();
+			stack.pop_back();
+
+			const auto& relationship = _context->_registry.get<RelationshipComponent>(entity);
+			_rows.push_back({ entity, depth, !relationship.children.empty() });
+
+			if (!_expandedEntities.count(_context->_registry.get<IDComponent>(entity).id))
+				continue;
+
+			for (auto it = relationship.children.rbegin(); it != relationship.children.rend(); ++it)
+			{
+				if (Entity child = _context->getEntityByUUID(*it))
+					stack.emplace_back(child, depth + 1);
+			}
+		}
+
+		_rowsHierarchyVersion = _context->getHierarchyVersion();
+		_rowsDirty = false;
 	}
 
 	void SceneHierarchyPanel::onImGuiRender()
 	{
 		ImGui::Begin("Scene Hierarchy");
 
-		_context->_registry.each([&](auto entityID)
+		if (_entityListHasHoles)
+			compactEntityList();
+
+		ImGui::PushItemWidth(-1);
+		if (ImGui::InputTextWithHint("##Search", "Search...", _filter, sizeof(_filter)))
 		{
-			Entity entity = { entityID, _context.get() };
-			drawEntityNode(entity);
-		});
+			_activeFilter = toLower(_filter);
+			_filterDirty = true;
+		}
+		ImGui::PopItemWidth();
+
+		if (!_activeFilter.empty())
+			updateFilter();
+
+		// Only the rows in view are laid out. Search results are shown flat
+		ImGuiListClipper clipper;
+		if (_activeFilter.empty())
+		{
+			if (_rowsDirty || _rowsHierarchyVersion != _context->getHierarchyVersion())
+				rebuildRows();
+
+			clipper.Begin((int)_rows.size());
+			while (clipper.Step())
+			{
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+					drawEntityNode({ _rows[i].entity, _context.get() }, _rows[i].depth, _rows[i].hasChildren);
+			}
+		}
+		else
+		{
+			clipper.Begin((int)_filteredEntities.size());
+			while (clipper.Step())
+			{
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+					drawEntityNode({ _filteredEntities[i], _context.get() }, 0, false);
+			}
+		}
+
+		// Dropping below the entities turns the dragged one into a root
+		ImGui::Dummy(ImVec2(ImGui::GetContentRegionAvail().x, std::max(ImGui::GetContentRegionAvail().y, ImGui::GetFrameHeight())));
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+			{
+				_reparentEntity = *(const entt::entity*)payload->Data;
+				_reparentTarget = entt::null;
+				_reparentRequested = true;
+			}
+			ImGui::EndDragDropTarget();
+		}
+
+		if (_reparentRequested)
+		{
+			if (_context->isEntityValid(_reparentEntity))
+			{
+				Entity target = _reparentTarget != entt::null ? Entity(_reparentTarget, _context.get()) : Entity();
+				_context->setParent({ _reparentEntity, _context.get() }, target);
+				if (target)
+					_expandedEntities.insert(target.getUUID());
+			}
+
+			_reparentRequested = false;
+		}
+
+		if (_entityToDelete != entt::null)
+		{
+			// Children go with their parent, the selection may be among them
+			_context->destroyEntity({ _entityToDelete, _context.get() });
+			if (_selectedEntity && !_context->isEntityValid(_selectedEntity))
+				_selectedEntity = {};
+
+			_entityToDelete = entt::null;
+		}
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 			_selectedEntity = {};
@@ -67,41 +339,103 @@ namespace Azteck
 		_selectedEntity = {};
 	}
 
-	void SceneHierarchyPanel::drawEntityNode(Entity entity)
+	void SceneHierarchyPanel::drawEntityNode(Entity entity, uint32_t depth, bool hasChildren)
 	{
 		auto& tag = entity.getComponent<TagComponent>().tag;
 
-		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
+		// Rows are flat, the tree is drawn through indentation and the open state kept here
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (!hasChildren)
+			flags |= ImGuiTreeNodeFlags_Leaf;
 		if (_selectedEntity == entity)
 			flags |= ImGuiTreeNodeFlags_Selected;
 
+		const float indent = depth * ImGui::GetStyle().IndentSpacing;
+		if (indent > 0.0f)
+			ImGui::Indent(indent);
+
+		const UUID uuid = entity.getUUID();
+		const bool isExpanded = hasChildren && _expandedEntities.count(uuid);
+		ImGui::SetNextItemOpen(isExpanded);
+
 		bool isOpened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
 
+		if (hasChildren && isOpened != isExpanded)
+		{
+			if (isOpened)
+				_expandedEntities.insert(uuid);
+			else
+				_expandedEntities.erase(uuid);
+
+			_rowsDirty = true;
+		}
+
 		if (ImGui::IsItemClicked())
 			_selectedEntity = entity;
 
-		bool entityDeleted = false;
+		if (ImGui::BeginDragDropSource())
+		{
+			entt::entity handle = entity;
+			ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &handle, sizeof(handle));
+			ImGui::Text("%s", tag.c_str());
+			ImGui::EndDragDropSource();
+		}
+
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+			{
+				_reparentEntity = *(const entt::entity*)payload->Data;
+				_reparentTarget = entity;
+				_reparentRequested = true;
+			}
+			ImGui::EndDragDropTarget();
+		}
+
+		if (indent > 0.0f)
+			ImGui::Unindent(indent);
+
 		if (ImGui::BeginPopupContextItem())
 		{
+			if (ImGui::MenuItem("Create Child Entity"))
+			{
+				_context->setParent(_context->createEntity("Empty Entity"), entity);
+				_expandedEntities.insert(uuid);
+			}
+
 			if (ImGui::MenuItem("Delete Entity"))
-				entityDeleted = true;
+				_entityToDelete = entity;
 
 			ImGui::EndPopup();
 		}
+	}
 
-		if (isOpened)
-			ImGui::TreePop();
+	struct SpriteSnapshot
+	{
+		glm::vec4 color;
+		Ref<Texture2D> texture;
+		float tilingFactor;
+		bool isStatic;
+	};
 
-		if (entityDeleted)
-		{
-			_context->destroyEntity(entity);
-			if (_selectedEntity == entity)
-				_selectedEntity = {};
-		}
+	static bool takeSpriteSnapshot(Entity entity, SpriteSnapshot& snapshot)
+	{
+		if (!entity.hasComponent<SpriteRendererComponent>())
+			return false;
+
+		const auto& sprite = entity.getComponent<SpriteRendererComponent>();
+		snapshot = { sprite.color, sprite.texture, sprite.tilingFactor, sprite.isStatic };
+		return true;
 	}
 
 	void SceneHierarchyPanel::drawComponents(Entity entity)
 	{
+		// Static sprites are baked and world transforms are only rebuilt for reported entities,
+		// so edits made through the widgets below have to be reported
+		SpriteSnapshot spriteBefore;
+		bool hadSprite = takeSpriteSnapshot(entity, spriteBefore);
+		const TransformComponent transformBefore = entity.getComponent<TransformComponent>();
+
 		if (entity.hasComponent<TagComponent>())
 		{
 			auto& tag = entity.getComponent<TagComponent>().tag;
@@ -111,7 +445,7 @@ namespace Azteck
 			strcpy_s(buffer, sizeof(buffer), tag.c_str());
 
 			if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
-				tag = buffer;
+				_context->setEntityName(entity, buffer);
 		}
 
 		ImGui::SameLine();
@@ -130,6 +464,8 @@ namespace Azteck
 			displayAddComponentEntry<BoxCollider2DComponent>("Box Collider 2D");
 			displayAddComponentEntry<CircleCollider2DComponent>("Circle Collider 2D");
 			displayAddComponentEntry<TextComponent>("Text Component");
+			displayAddComponentEntry<TilemapComponent>("Tilemap");
+			displayAddComponentEntry<ParticleEmitterComponent>("Particle Emitter");
 
 			ImGui::EndPopup();
 		}
@@ -301,6 +637,7 @@ namespace Azteck
 			}
 
 			ImGui::DragFloat("Tiling Factor", &component.tilingFactor, 0.1f, 0.0f, 100.0f);
+			ImGui::Checkbox("Static", &component.isStatic);
 		});
 
 		drawComponent<CircleRendererComponent>("Circle Renderer", entity, [](auto& component)
@@ -343,6 +680,7 @@ namespace Azteck
 			ImGui::DragFloat("Friction", &component.friction, 0.01f, 0.0f, 1.0f);
 			ImGui::DragFloat("Restitution", &component.restitution, 0.01f, 0.0f, 1.0f);
 			ImGui::DragFloat("Restitution Threshold", &component.restitutionThreshold, 0.01f, 0.0f);
+			ImGui::Checkbox("Is Trigger", &component.isTrigger);
 		});
 
 		drawComponent<CircleCollider2DComponent>("Circle Collider 2D", entity, [](auto& component)
@@ -353,15 +691,96 @@ namespace Azteck
 			ImGui::DragFloat("Friction", &component.friction, 0.01f, 0.0f, 1.0f);
 			ImGui::DragFloat("Restitution", &component.restitution, 0.01f, 0.0f, 1.0f);
 			ImGui::DragFloat("Restitution Threshold", &component.restitutionThreshold, 0.01f, 0.0f);
+			ImGui::Checkbox("Is Trigger", &component.isTrigger);
 		});
 
 		drawComponent<TextComponent>("Text Renderer", entity, [](auto& component)
 		{
-			ImGui::InputTextMultiline("Text String", &component.textString);
+			if (ImGui::InputTextMultiline("Text String", &component.textString))
+				component.layout.invalidate();
+
 			ImGui::ColorEdit4("Color", glm::value_ptr(component.color));
 			ImGui::DragFloat("Kerning", &component.kerning, 0.025f);
 			ImGui::DragFloat("Line Spacing", &component.lineSpacing, 0.025f);
 		});
+
+		drawComponent<TilemapComponent>("Tilemap", entity, [](auto& component)
+		{
+			int size[2] = { (int)component.width, (int)component.height };
+			if (ImGui::DragInt2("Size", size, 1.0f, 0, 4096))
+				component.resize((uint32_t)std::max(size[0], 0), (uint32_t)std::max(size[1], 0));
+
+			if (ImGui::DragFloat2("Tile Size", glm::value_ptr(component.tileSize), 0.05f, 0.01f, 100.0f))
+				component.invalidate();
+
+			if (ImGui::ColorEdit4("Color", glm::value_ptr(component.color)))
+				component.invalidate();
+
+			ImGui::Button("Tileset", ImVec2(100.0f, 0.0f));
+			if (ImGui::BeginDragDropTarget())
+			{
+				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
+				{
+					const wchar_t* path = (const wchar_t*)payload->Data;
+					std::filesystem::path texturePath(path);
+
+					Ref<Texture2D> texture = Texture2D::create(texturePath.string());
+					if (texture->isLoaded())
+					{
+						component.tileset = texture;
+						component.invalidate();
+					}
+					else
+					{
+						AZ_WARN("Could not load texture {0}", texturePath.filename().string());
+					}
+				}
+				ImGui::EndDragDropTarget();
+			}
+
+			int tilesetSize[2] = { (int)component.tilesetColumns, (int)component.tilesetRows };
+			if (ImGui::DragInt2("Tileset Cells", tilesetSize, 1.0f, 1, 256))
+			{
+				component.tilesetColumns = (uint32_t)std::max(tilesetSize[0], 1);
+				component.tilesetRows = (uint32_t)std::max(tilesetSize[1], 1);
+				component.invalidate();
+			}
+		});
+
+		drawComponent<ParticleEmitterComponent>("Particle Emitter", entity, [](auto& component)
+		{
+			auto& props = component.props;
+
+			ImGui::Checkbox("Emitting", &component.emitting);
+			ImGui::DragFloat("Emission Rate", &props.emissionRate, 1.0f, 0.0f, 100000.0f);
+
+			int maxParticles = (int)props.maxParticles;
+			if (ImGui::DragInt("Max Particles", &maxParticles, 10.0f, 0, 1000000))
+				props.maxParticles = (uint32_t)std::max(maxParticles, 0);
+
+			ImGui::DragFloat("Lifetime", &props.lifetime, 0.01f, 0.01f, 100.0f);
+			ImGui::DragFloat("Lifetime Variation", &props.lifetimeVariation, 0.01f, 0.0f, 100.0f);
+			ImGui::DragFloat2("Velocity", glm::value_ptr(props.velocity), 0.05f);
+			ImGui::DragFloat2("Velocity Variation", glm::value_ptr(props.velocityVariation), 0.05f, 0.0f);
+			ImGui::DragFloat2("Acceleration", glm::value_ptr(props.acceleration), 0.05f);
+			ImGui::ColorEdit4("Color Begin", glm::value_ptr(props.colorBegin));
+			ImGui::ColorEdit4("Color End", glm::value_ptr(props.colorEnd));
+			ImGui::DragFloat("Size Begin", &props.sizeBegin, 0.005f, 0.0f, 100.0f);
+			ImGui::DragFloat("Size End", &props.sizeEnd, 0.005f, 0.0f, 100.0f);
+		});
+
+		const auto& transformAfter = entity.getComponent<TransformComponent>();
+		if (transformBefore.translation != transformAfter.translation || transformBefore.rotation != transformAfter.rotation
+			|| transformBefore.scale != transformAfter.scale)
+			_context->markTransformDirty(entity);
+
+		SpriteSnapshot spriteAfter;
+		if (hadSprite && takeSpriteSnapshot(entity, spriteAfter) && (spriteBefore.isStatic || spriteAfter.isStatic))
+		{
+			if (spriteBefore.color != spriteAfter.color || spriteBefore.texture != spriteAfter.texture
+				|| spriteBefore.tilingFactor != spriteAfter.tilingFactor || spriteBefore.isStatic != spriteAfter.isStatic)
+				_context->markStaticBatchesDirty();
+		}
 	}
 
 	template<typename T, typename UIFunction>
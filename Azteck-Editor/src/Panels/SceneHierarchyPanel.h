@@ -14,6 +14,7 @@ namespace Azteck
 	public:
 		SceneHierarchyPanel() = default;
 		SceneHierarchyPanel(const Ref<Scene>& context);
+		~SceneHierarchyPanel();
 
 		void setContext(const Ref<Scene>& context);
 
@@ -25,7 +26,19 @@ namespace Azteck
 		void clearSelection();
 
 	private:
-		void drawEntityNode(Entity entity);
+		void connectSignals();
+		void disconnectSignals();
+
+		void onEntityCreated(entt::registry& registry, entt::entity entity);
+		void onEntityDestroyed(entt::registry& registry, entt::entity entity);
+		void onTagChanged(entt::registry& registry, entt::entity entity);
+
+		void rebuildEntityList();
+		void compactEntityList();
+		void updateFilter();
+		void rebuildRows();
+
+		void drawEntityNode(Entity entity, uint32_t depth, bool hasChildren);
 		void drawComponents(Entity entity);
 
 		template<typename T, typename UIFunction>
@@ -39,5 +52,42 @@ namespace Azteck
 	private:
 		Ref<Scene> _context;
 		Entity _selectedEntity;
+
+		// Entities of the context in creation order, kept current by registry signals.
+		// Destroyed entities leave a null slot until the next compaction
+		std::vector<entt::entity> _entityList;
+		std::unordered_map<entt::entity, size_t> _entityListIndex;
+		bool _entityListHasHoles = false;
+
+		// Lowercase names searched by the filter, rebuilt only after entities or names changed
+		std::vector<std::pair<entt::entity, std::string>> _searchIndex;
+		// Every 1, 2 and 3 character substring of the names to the slots containing it, in
+		// slot order. A search only checks the slots of its rarest gram
+		std::unordered_map<uint32_t, std::vector<uint32_t>> _searchGrams;
+		bool _searchIndexDirty = true;
+
+		char _filter[256] = {};
+		std::string _activeFilter;
+		std::vector<entt::entity> _filteredEntities;
+		bool _filterDirty = true;
+
+		// Visible rows of the tree, only expanded entities contribute their children
+		struct HierarchyRow
+		{
+			entt::entity entity;
+			uint32_t depth;
+			bool hasChildren;
+		};
+
+		std::vector<HierarchyRow> _rows;
+		std::unordered_set<UUID> _expandedEntities;
+		uint64_t _rowsHierarchyVersion = 0;
+		bool _rowsDirty = true;
+
+		// Applied after the rows are drawn, they must stay valid until then
+		entt::entity _entityToDelete = entt::null;
+		entt::entity _reparentEntity = entt::null;
+		entt::entity _reparentTarget = entt::null;
+		bool _reparentRequested = false;
 	};
 }
@@ -0,0 +1,371 @@
+#include "azpch.h"
+#include "ThumbnailCache.h"
+
+#include "Azteck/Project/Project.h"
+#include "Azteck/Renderer/EditorCamera.h"
+#include "Azteck/Renderer/RenderCommand.h"
+#include "Azteck/Scene/Scene.h"
+#include "Azteck/Scene/SceneSerializer.h"
+
+#include <stb_image.h>
+
+namespace Azteck
+{
+	static constexpr uint32_t workerCount = 2;
+
+	struct ThumbnailFileHeader
+	{
+		char magic[4] = { 'A', 'Z', 'T', 'H' };
+		uint32_t version = 1;
+		uint32_t size = ThumbnailCache::thumbnailSize;
+	};
+
+	namespace Utils
+	{
+		static uint64_t hashString(const std::string& string)
+		{
+			// FNV-1a
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : string)
+			{
+				hash ^= (uint8_t)c;
+				hash *= 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		static std::filesystem::path getThumbnailCacheDirectory()
+		{
+			return Project::getProjectDirectory() / "Cache" / "Thumbnails";
+		}
+
+		static std::filesystem::path getThumbnailCachePath(uint64_t key)
+		{
+			std::stringstream ss;
+			ss << std::hex << std::setw(16) << std::setfill('0') << key << ".azthumb";
+			return getThumbnailCacheDirectory() / ss.str();
+		}
+
+		static bool loadCachedThumbnail(uint64_t key, std::vector<uint8_t>& outPixels)
+		{
+			std::ifstream stream(getThumbnailCachePath(key), std::ios::binary);
+			if (!stream)
+				return false;
+
+			ThumbnailFileHeader expected;
+			ThumbnailFileHeader header;
+			stream.read((char*)&header, sizeof(header));
+			if (!stream || memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0
+				|| header.version != expected.version || header.size != expected.size)
+				return false;
+
+			outPixels.resize((size_t)header.size * header.size * 4);
+			stream.read((char*)outPixels.data(), outPixels.size());
+
+			return (bool)stream;
+		}
+
+		static void saveCachedThumbnail(uint64_t key, const std::vector<uint8_t>& pixels)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(getThumbnailCacheDirectory(), error);
+
+			std::ofstream stream(getThumbnailCachePath(key), std::ios::binary);
+			if (!stream)
+			{
+				AZ_CORE_WARN("Failed to write thumbnail cache file {0}", getThumbnailCachePath(key).string());
+				return;
+			}
+
+			ThumbnailFileHeader header;
+			stream.write((const char*)&header, sizeof(header));
+			stream.write((const char*)pixels.data(), pixels.size());
+		}
+
+		// Box filters the image into the middle of a transparent square, keeping its aspect ratio
+		static void scaleToThumbnail(const uint8_t* source, uint32_t width, uint32_t height, std::vector<uint8_t>& outPixels)
+		{
+			const uint32_t size = ThumbnailCache::thumbnailSize;
+			outPixels.assign((size_t)size * size * 4, 0);
+
+			float scale = std::min(1.0f, (float)size / (float)std::max(width, height));
+			uint32_t scaledWidth = std::max(1u, (uint32_t)(width * scale));
+			uint32_t scaledHeight = std::max(1u, (uint32_t)(height * scale));
+			uint32_t offsetX = (size - scaledWidth) / 2;
+			uint32_t offsetY = (size - scaledHeight) / 2;
+
+			for (uint32_t y = 0; y < scaledHeight; y++)
+			{
+				uint32_t sourceY0 = y * height / scaledHeight;
+				uint32_t sourceY1 = std::max(sourceY0 + 1, (y + 1) * height / scaledHeight);
+
+				for (uint32_t x = 0; x < scaledWidth; x++)
+				{
+					uint32_t sourceX0 = x * width / scaledWidth;
+					uint32_t sourceX1 = std::max(sourceX0 + 1, (x + 1) * width / scaledWidth);
+
+					uint32_t sum[4] = { 0, 0, 0, 0 };
+					for (uint32_t sy = sourceY0; sy < sourceY1; sy++)
+					{
+						const uint8_t* row = source + ((size_t)sy * width + sourceX0) * 4;
+						for (uint32_t sx = sourceX0; sx < sourceX1; sx++, row += 4)
+						{
+							sum[0] += row[0];
+							sum[1] += row[1];
+							sum[2] += row[2];
+							sum[3] += row[3];
+						}
+					}
+
+					uint32_t count = (sourceX1 - sourceX0) * (sourceY1 - sourceY0);
+					uint8_t* target = outPixels.data() + ((size_t)(y + offsetY) * size + x + offsetX) * 4;
+					for (int c = 0; c < 4; c++)
+						target[c] = (uint8_t)(sum[c] / count);
+				}
+			}
+		}
+
+		static uint64_t thumbnailKey(const std::filesystem::path& path, std::filesystem::file_time_type lastWriteTime)
+		{
+			uint64_t hash = hashString(path.generic_string());
+			hash ^= (uint64_t)lastWriteTime.time_since_epoch().count() + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	}
+
+	ThumbnailCache::ThumbnailCache()
+	{
+		for (uint32_t i = 0; i < workerCount; i++)
+			_workers.emplace_back(&ThumbnailCache::workerLoop, this);
+	}
+
+	ThumbnailCache::~ThumbnailCache()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(_mutex);
+			_running = false;
+			_requests.clear();
+		}
+		_wakeCondition.notify_all();
+
+		for (auto& worker : _workers)
+			worker.join();
+	}
+
+	Ref<Texture2D> ThumbnailCache::getThumbnail(const std::filesystem::path& path, std::filesystem::file_time_type lastWriteTime)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+		ThumbnailType type = ThumbnailType::None;
+		if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp")
+			type = ThumbnailType::Image;
+		else if (extension == ".yaml")
+			type = ThumbnailType::Scene;
+
+		if (type == ThumbnailType::None)
+			return nullptr;
+
+		const std::string pathString = path.string();
+		const uint64_t key = Utils::thumbnailKey(path, lastWriteTime);
+
+		auto it = _entries.find(pathString);
+		if (it != _entries.end())
+		{
+			CacheEntry& entry = it->second;
+			_lruOrder.splice(_lruOrder.begin(), _lruOrder, entry.lruPosition);
+
+			// The file changed since, keep showing the old preview until the new one is done
+			if (entry.key != key && !entry.pending)
+			{
+				entry.key = key;
+				entry.pending = true;
+
+				std::scoped_lock<std::mutex> lock(_mutex);
+				_requests.push_back({ path, key, type });
+				_wakeCondition.notify_one();
+			}
+
+			return entry.texture;
+		}
+
+		_lruOrder.push_front(pathString);
+
+		CacheEntry& entry = _entries[pathString];
+		entry.key = key;
+		entry.lruPosition = _lruOrder.begin();
+
+		{
+			std::scoped_lock<std::mutex> lock(_mutex);
+			_requests.push_back({ path, key, type });
+		}
+		_wakeCondition.notify_one();
+
+		evictTextures();
+
+		return nullptr;
+	}
+
+	void ThumbnailCache::update()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		std::vector<ThumbnailResult> results;
+		{
+			std::scoped_lock<std::mutex> lock(_mutex);
+			results.swap(_results);
+		}
+
+		for (auto& result : results)
+		{
+			if (result.needsRender)
+				_pendingScenes.push_back(std::move(result.request));
+			else
+				finishThumbnail(result.request, result.pixels);
+		}
+	}
+
+	void ThumbnailCache::renderPendingPreviews()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		// Rendering a scene is expensive, spread them over frames
+		if (_pendingScenes.empty())
+			return;
+
+		ThumbnailRequest request = std::move(_pendingScenes.back());
+		_pendingScenes.pop_back();
+
+		std::vector<uint8_t> pixels;
+		renderScenePreview(request, pixels);
+		if (!pixels.empty())
+			Utils::saveCachedThumbnail(request.key, pixels);
+
+		finishThumbnail(request, pixels);
+	}
+
+	void ThumbnailCache::workerLoop()
+	{
+		while (true)
+		{
+			ThumbnailRequest request;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_wakeCondition.wait(lock, [this]() { return !_running || !_requests.empty(); });
+
+				if (!_running)
+					return;
+
+				// Newest first, those are the files currently in view
+				request = std::move(_requests.back());
+				_requests.pop_back();
+			}
+
+			ThumbnailResult result;
+			result.request = request;
+			processRequest(request, result);
+
+			std::scoped_lock<std::mutex> lock(_mutex);
+			_results.push_back(std::move(result));
+		}
+	}
+
+	void ThumbnailCache::processRequest(const ThumbnailRequest& request, ThumbnailResult& outResult)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (Utils::loadCachedThumbnail(request.key, outResult.pixels))
+			return;
+
+		if (request.type == ThumbnailType::Scene)
+		{
+			outResult.needsRender = true;
+			return;
+		}
+
+		// Same orientation textures are loaded with, the main thread always sets it to this value too
+		stbi_set_flip_vertically_on_load(1);
+
+		int width, height, channels;
+		stbi_uc* data = stbi_load(request.path.string().c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			AZ_CORE_WARN("Failed to decode thumbnail for {0}", request.path.string());
+			return;
+		}
+
+		Utils::scaleToThumbnail(data, (uint32_t)width, (uint32_t)height, outResult.pixels);
+		stbi_image_free(data);
+
+		Utils::saveCachedThumbnail(request.key, outResult.pixels);
+	}
+
+	void ThumbnailCache::renderScenePreview(const ThumbnailRequest& request, std::vector<uint8_t>& outPixels)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		Ref<Scene> scene = createRef<Scene>();
+		SceneSerializer serializer(scene);
+		serializer.setLoadScriptFields(false);
+		if (!serializer.deserialize(request.path.string()))
+			return;
+
+		if (!_previewFrameBuffer)
+		{
+			FrameBufferSpecification spec;
+			spec.attachments = { FrameBufferTextureFormat::RGBA8, FrameBufferTextureFormat::RED_INTEGER, FrameBufferTextureFormat::Depth };
+			spec.width = thumbnailSize;
+			spec.height = thumbnailSize;
+			_previewFrameBuffer = FrameBuffer::create(spec);
+		}
+
+		EditorCamera camera(30.0f, 1.0f, 0.1f, 1000.0f);
+		camera.setViewportSize((float)thumbnailSize, (float)thumbnailSize);
+		scene->onViewportResize(thumbnailSize, thumbnailSize);
+
+		_previewFrameBuffer->bind();
+		RenderCommand::setClearColor(glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+		RenderCommand::clear();
+		_previewFrameBuffer->clearAttachment(1, -1);
+
+		scene->onUpdateEditor(0.0f, camera);
+
+		outPixels.resize((size_t)thumbnailSize * thumbnailSize * 4);
+		_previewFrameBuffer->readColorAttachment(0, outPixels.data(), (uint32_t)outPixels.size());
+		_previewFrameBuffer->unbind();
+	}
+
+	void ThumbnailCache::finishThumbnail(const ThumbnailRequest& request, std::vector<uint8_t>& pixels)
+	{
+		auto it = _entries.find(request.path.string());
+
+		// Evicted or outdated while it was generated
+		if (it == _entries.end() || it->second.key != request.key)
+			return;
+
+		CacheEntry& entry = it->second;
+		entry.pending = false;
+
+		if (pixels.empty())
+			return;
+
+		TextureSpecification spec;
+		spec.width = thumbnailSize;
+		spec.height = thumbnailSize;
+		spec.format = ImageFormat::RGBA8;
+		spec.generateMips = false;
+
+		entry.texture = Texture2D::create(spec);
+		entry.texture->setData(pixels.data(), (uint32_t)pixels.size());
+	}
+
+	void ThumbnailCache::evictTextures()
+	{
+		while (_entries.size() > maxTextures)
+		{
+			_entries.erase(_lruOrder.back());
+			_lruOrder.pop_back();
+		}
+	}
+}
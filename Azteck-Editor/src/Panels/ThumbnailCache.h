@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Azteck/Renderer/Texture.h"
+#include "Azteck/Renderer/FrameBuffer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace Azteck
+{
+	// Previews for the content browser. Images are decoded and scaled on worker threads,
+	// scenes are rendered off-screen on the main thread. Both end up in a bounded LRU of
+	// textures and in an on-disk cache keyed by path and modification time
+	class ThumbnailCache
+	{
+	public:
+		static constexpr uint32_t thumbnailSize = 128;
+		static constexpr size_t maxTextures = 256;
+
+		ThumbnailCache();
+		~ThumbnailCache();
+
+		// Null while the thumbnail is generated or if the file has no preview
+		Ref<Texture2D> getThumbnail(const std::filesystem::path& path, std::filesystem::file_time_type lastWriteTime);
+
+		// Uploads finished thumbnails, call once per frame
+		void update();
+		// Renders one pending scene preview, call outside of any other render pass
+		void renderPendingPreviews();
+
+	private:
+		enum class ThumbnailType
+		{
+			None = 0,
+			Image,
+			Scene
+		};
+
+		struct ThumbnailRequest
+		{
+			std::filesystem::path path;
+			uint64_t key;
+			ThumbnailType type;
+		};
+
+		struct ThumbnailResult
+		{
+			ThumbnailRequest request;
+			std::vector<uint8_t> pixels;
+			// Scenes missing from the disk cache come back to be rendered
+			bool needsRender = false;
+		};
+
+		struct CacheEntry
+		{
+			Ref<Texture2D> texture;
+			uint64_t key = 0;
+			bool pending = true;
+			std::list<std::string>::iterator lruPosition;
+		};
+
+		void workerLoop();
+		void processRequest(const ThumbnailRequest& request, ThumbnailResult& outResult);
+
+		void renderScenePreview(const ThumbnailRequest& request, std::vector<uint8_t>& outPixels);
+		void finishThumbnail(const ThumbnailRequest& request, std::vector<uint8_t>& pixels);
+
+		void evictTextures();
+
+	private:
+		std::unordered_map<std::string, CacheEntry> _entries;
+		// Most recently used first
+		std::list<std::string> _lruOrder;
+
+		std::vector<ThumbnailRequest> _pendingScenes;
+		Ref<FrameBuffer> _previewFrameBuffer;
+
+		std::vector<std::thread> _workers;
+		std::mutex _mutex;
+		std::condition_variable _wakeCondition;
+		std::deque<ThumbnailRequest> _requests;
+		std::vector<ThumbnailResult> _results;
+		bool _running = true;
+	};
+}
@@ -0,0 +1,61 @@
+#include <Azteck.h>
+
+#include "Azteck/Core/EntryPoint.h"
+#include "HeadlessLayer.h"
+
+namespace Azteck 
+{
+	class AzteckHeadless : public Application
+	{
+	public:
+		AzteckHeadless(const ApplicationSpecification& spec, const HeadlessSettings& settings)
+			: Application(spec)
+		{
+			_headlessLayer = new HeadlessLayer(settings);
+			pushLayer(_headlessLayer);
+		}
+
+		~AzteckHeadless()
+		{
+			// Layers are detached after the engine shut down, the scene has to stop before that
+			_headlessLayer->stop();
+		}
+
+	private:
+		HeadlessLayer* _headlessLayer;
+	};
+
+	// Azteck-Headless <project.azproj> [--scene <path>] [--frames <count>] [--timestep <seconds>]
+	Application* createApplication(ApplicationCommandLineArgs args)
+	{
+		ApplicationSpecification spec;
+		spec.name = "Headless";
+		spec.args = args;
+		spec.headless = true;
+		spec.workingDirectory = "../Azteck-Editor";
+
+		HeadlessSettings settings;
+
+		for (int i = 1; i < args.count; i++)
+		{
+			std::string_view arg = args[i];
+			bool hasValue = i + 1 < args.count;
+
+			if (arg == "--scene" && hasValue)
+				settings.scenePath = std::filesystem::absolute(args[++i]);
+			else if (arg == "--frames" && hasValue)
+				spec.maxFrames = std::stoull(args[++i]);
+			else if (arg == "--timestep" && hasValue)
+				spec.fixedTimestep = std::stof(args[++i]);
+			else if (settings.projectPath.empty())
+				settings.projectPath = std::filesystem::absolute(args[i]);
+			else
+				AZ_WARN("Unknown argument {0}", arg);
+		}
+
+		if (settings.projectPath.empty())
+			AZ_ERROR("Usage: Azteck-Headless <project.azproj> [--scene <path>] [--frames <count>] [--timestep <seconds>]");
+
+		return new AzteckHeadless(spec, settings);
+	}
+}
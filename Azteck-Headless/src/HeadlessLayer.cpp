@@ -0,0 +1,89 @@
+#include "HeadlessLayer.h"
+
+#include "Azteck/Core/Timer.h"
+#include "Azteck/Scene/SceneSerializer.h"
+#include "Azteck/Scripting/ScriptEngine.h"
+
+#include "Platform/Headless/RenderRecorder.h"
+
+namespace Azteck
+{
+	HeadlessLayer::HeadlessLayer(const HeadlessSettings& settings)
+		: Layer("HeadlessLayer")
+		, _settings(settings)
+	{
+	}
+
+	void HeadlessLayer::onAttach()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (!Project::load(_settings.projectPath))
+		{
+			AZ_ERROR("Could not load project {0}", _settings.projectPath.string());
+			Application::getInstance().close();
+			return;
+		}
+
+		ScriptEngine::init();
+
+		std::filesystem::path scenePath = _settings.scenePath.empty()
+			? Project::getAssetFileSystemPath(Project::getActive()->getConfig().startScenePath)
+			: _settings.scenePath;
+
+		Ref<Scene> scene = createRef<Scene>();
+		SceneSerializer serializer(scene);
+		if (!serializer.deserialize(scenePath.string()))
+		{
+			AZ_ERROR("Could not load scene {0}", scenePath.string());
+			Application::getInstance().close();
+			return;
+		}
+
+		AZ_INFO("Running {0} headless", scenePath.filename().string());
+
+		_scene = scene;
+		_scene->onViewportResize(_settings.viewportWidth, _settings.viewportHeight);
+		_scene->onRuntimeStart();
+
+		// Only the frames should show up in the render statistics
+		RenderRecorder::reset();
+	}
+
+	void HeadlessLayer::onDetach()
+	{
+		stop();
+	}
+
+	void HeadlessLayer::onUpdate(Timestep timestep)
+	{
+		if (!_scene)
+			return;
+
+		Timer timer;
+		_scene->onUpdateRuntime(timestep);
+		float millis = timer.elapsedMillis();
+
+		_frameCount++;
+		_simulatedTime += timestep.getSeconds();
+		_totalUpdateMillis += millis;
+		_maxUpdateMillis = std::max(_maxUpdateMillis, millis);
+	}
+
+	void HeadlessLayer::stop()
+	{
+		if (!_scene)
+			return;
+
+		_scene->onRuntimeStop();
+		_scene = nullptr;
+
+		double averageMillis = _frameCount != 0 ? _totalUpdateMillis / _frameCount : 0.0;
+		AZ_INFO("Simulated {0} frames ({1:.2f}s), update average {2:.3f}ms, max {3:.3f}ms",
+			_frameCount, _simulatedTime, averageMillis, _maxUpdateMillis);
+
+		const RenderRecorder::Statistics& renderStats = RenderRecorder::getStatistics();
+		AZ_INFO("Rendering issued {0} draw calls and uploaded {1} bytes",
+			renderStats.drawCalls, renderStats.getTotalBytesUploaded());
+	}
+}
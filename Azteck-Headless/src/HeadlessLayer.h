@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Azteck.h>
+
+namespace Azteck
+{
+	struct HeadlessSettings
+	{
+		std::filesystem::path projectPath;
+		// Empty runs the start scene of the project
+		std::filesystem::path scenePath;
+
+		// Cameras still need an aspect ratio without a window
+		uint32_t viewportWidth = 1280;
+		uint32_t viewportHeight = 720;
+	};
+
+	// Loads a project and plays one scene without a window, timing every update
+	class HeadlessLayer : public Layer
+	{
+	public:
+		HeadlessLayer(const HeadlessSettings& settings);
+		virtual ~HeadlessLayer() = default;
+
+		void onAttach() override;
+		void onDetach() override;
+
+		void onUpdate(Timestep timestep) override;
+
+		// Stops the scene and logs the timings, has to happen before the script engine shuts down
+		void stop();
+
+	private:
+		HeadlessSettings _settings;
+		Ref<Scene> _scene;
+
+		uint64_t _frameCount = 0;
+		float _simulatedTime = 0.0f;
+		double _totalUpdateMillis = 0.0;
+		float _maxUpdateMillis = 0.0f;
+	};
+}
@@ -35,15 +35,52 @@ namespace Azteck
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static ulong Entity_FindEntityByName(string name);
 
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static uint Entity_GetNameHandle(string name);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong Entity_FindEntityByNameHandle(uint handle);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static string Entity_GetName(ulong entityID);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_SetName(ulong entityID, string name);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong Entity_GetParent(ulong entityID);
+
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_SetParent(ulong entityID, ulong parentID);
+
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static object GetScriptInstance(ulong entityID);
 
+		#region Physics2D
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool Physics2D_Raycast(ref Vector2 start, ref Vector2 end, out RaycastHit2D hit);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Physics2D_RaycastAll(ref Vector2 start, ref Vector2 end);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Physics2D_RaycastBatch(Vector2[] starts, Vector2[] ends);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Physics2D_OverlapBox(ref Vector2 center, ref Vector2 halfExtents, float angle);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Physics2D_OverlapCircle(ref Vector2 center, float radius);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool Physics2D_BoxCast(ref Vector2 center, ref Vector2 halfExtents, float angle, ref Vector2 translation, out RaycastHit2D hit);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool Physics2D_CircleCast(ref Vector2 center, float radius, ref Vector2 translation, out RaycastHit2D hit);
+		#endregion
+
 		#region TextComponent
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static string TextComponent_GetText(ulong entityID);
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static void TextComponent_SetText(ulong entityID, string text);
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TextComponent_AppendText(ulong entityID, string text);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static void TextComponent_GetColor(ulong entityID, out Vector4 color);
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static void TextComponent_SetColor(ulong entityID, ref Vector4 color);
@@ -56,5 +93,25 @@ namespace Azteck
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static void TextComponent_SetLineSpacing(ulong entityID, float lineSpacing);
 		#endregion
+
+		#region TilemapComponent
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static uint TilemapComponent_GetWidth(ulong entityID);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static uint TilemapComponent_GetHeight(ulong entityID);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ushort TilemapComponent_GetTile(ulong entityID, uint x, uint y);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void TilemapComponent_SetTile(ulong entityID, uint x, uint y, ushort tile);
+		#endregion
+
+		#region ParticleEmitterComponent
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool ParticleEmitterComponent_GetEmitting(ulong entityID);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void ParticleEmitterComponent_SetEmitting(ulong entityID, bool emitting);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void ParticleEmitterComponent_Burst(ulong entityID, uint count);
+		#endregion
 	}
 }
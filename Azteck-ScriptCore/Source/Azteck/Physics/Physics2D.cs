@@ -0,0 +1,62 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace Azteck
+{
+	[StructLayout(LayoutKind.Sequential)]
+	public struct RaycastHit2D
+	{
+		public ulong EntityID;
+		public Vector2 Point;
+		public Vector2 Normal;
+		public float Fraction;
+
+		public Entity Entity => EntityID != 0 ? new Entity(EntityID) : null;
+	}
+
+	public static class Physics2D
+	{
+		public static bool Raycast(Vector2 start, Vector2 end, out RaycastHit2D hit)
+		{
+			return InternalCalls.Physics2D_Raycast(ref start, ref end, out hit);
+		}
+
+		// Entity IDs of everything along the ray, closest first
+		public static ulong[] RaycastAll(Vector2 start, Vector2 end)
+		{
+			return InternalCalls.Physics2D_RaycastAll(ref start, ref end);
+		}
+
+		// Casts all rays in a single call, returns the closest entity ID per ray or 0 on a miss
+		public static ulong[] Raycast(Vector2[] starts, Vector2[] ends)
+		{
+			if (starts == null || ends == null)
+				return new ulong[0];
+
+			if (starts.Length != ends.Length)
+				throw new ArgumentException("Every ray needs a start and an end point");
+
+			return InternalCalls.Physics2D_RaycastBatch(starts, ends);
+		}
+
+		public static ulong[] OverlapBox(Vector2 center, Vector2 halfExtents, float angle = 0.0f)
+		{
+			return InternalCalls.Physics2D_OverlapBox(ref center, ref halfExtents, angle);
+		}
+
+		public static ulong[] OverlapCircle(Vector2 center, float radius)
+		{
+			return InternalCalls.Physics2D_OverlapCircle(ref center, radius);
+		}
+
+		public static bool BoxCast(Vector2 center, Vector2 halfExtents, float angle, Vector2 translation, out RaycastHit2D hit)
+		{
+			return InternalCalls.Physics2D_BoxCast(ref center, ref halfExtents, angle, ref translation, out hit);
+		}
+
+		public static bool CircleCast(Vector2 center, float radius, Vector2 translation, out RaycastHit2D hit)
+		{
+			return InternalCalls.Physics2D_CircleCast(ref center, radius, ref translation, out hit);
+		}
+	}
+}
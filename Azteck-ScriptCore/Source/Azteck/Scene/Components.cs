@@ -59,6 +59,12 @@
 			set => InternalCalls.TextComponent_SetText(Entity.ID, value);
 		}
 
+		// Cheaper than assigning Text for growing text, only the new part is laid out
+		public void AppendText(string text)
+		{
+			InternalCalls.TextComponent_AppendText(Entity.ID, text);
+		}
+
 		public Vector4 Color
 		{
 			get
@@ -85,4 +91,36 @@
 			set => InternalCalls.TextComponent_SetLineSpacing(Entity.ID, value);
 		}
 	}
+
+	public class TilemapComponent : Component
+	{
+		public uint Width => InternalCalls.TilemapComponent_GetWidth(Entity.ID);
+		public uint Height => InternalCalls.TilemapComponent_GetHeight(Entity.ID);
+
+		// 0 is an empty cell, other values are tileset indices plus one
+		public ushort GetTile(uint x, uint y)
+		{
+			return InternalCalls.TilemapComponent_GetTile(Entity.ID, x, y);
+		}
+
+		public void SetTile(uint x, uint y, ushort tile)
+		{
+			InternalCalls.TilemapComponent_SetTile(Entity.ID, x, y, tile);
+		}
+	}
+
+	public class ParticleEmitterComponent : Component
+	{
+		public bool Emitting
+		{
+			get => InternalCalls.ParticleEmitterComponent_GetEmitting(Entity.ID);
+			set => InternalCalls.ParticleEmitterComponent_SetEmitting(Entity.ID, value);
+		}
+
+		// Emits particles at once, independent of the emission rate
+		public void Burst(uint count)
+		{
+			InternalCalls.ParticleEmitterComponent_Burst(Entity.ID, count);
+		}
+	}
 }
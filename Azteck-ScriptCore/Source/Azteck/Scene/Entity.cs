@@ -13,6 +13,23 @@ namespace Azteck
 
 		public readonly ulong ID;
 
+		public string Name
+		{
+			get => InternalCalls.Entity_GetName(ID);
+			set => InternalCalls.Entity_SetName(ID, value);
+		}
+
+		// Translation, rotation and scale are relative to the parent
+		public Entity Parent
+		{
+			get
+			{
+				ulong parentID = InternalCalls.Entity_GetParent(ID);
+				return parentID == 0 ? null : new Entity(parentID);
+			}
+			set => InternalCalls.Entity_SetParent(ID, value?.ID ?? 0);
+		}
+
 		public Vector3 Translation
 		{
 			get
@@ -50,12 +67,58 @@ namespace Azteck
 			return new Entity(entityID);
 		}
 
+		// Cheaper than passing the string on every call, keep the EntityName around
+		public Entity FindEntityByName(EntityName name)
+		{
+			ulong entityID = InternalCalls.Entity_FindEntityByNameHandle(name.Handle);
+			if (entityID == 0)
+				return null;
+
+			return new Entity(entityID);
+		}
+
 		public T As<T>() where T : Entity, new()
 		{
 			object instance = InternalCalls.GetScriptInstance(ID);
 			return instance as T;
 		}
 
+		protected virtual void OnCollisionEnter(Entity other) { }
+		protected virtual void OnCollisionExit(Entity other) { }
+		protected virtual void OnTriggerEnter(Entity other) { }
+		protected virtual void OnTriggerExit(Entity other) { }
+
+		// Matches Contact2DEvent::Type on the native side
+		private enum ContactType : byte { CollisionEnter = 0, CollisionExit, TriggerEnter, TriggerExit }
+
+		// Called by the engine once per frame with every contact of that frame
+		internal static void DispatchContactEvents(Entity[] targets, ulong[] others, byte[] types)
+		{
+			for (int i = 0; i < targets.Length; i++)
+			{
+				Entity other = new Entity(others[i]);
+
+				switch ((ContactType)types[i])
+				{
+					case ContactType.CollisionEnter: targets[i].OnCollisionEnter(other); break;
+					case ContactType.CollisionExit:  targets[i].OnCollisionExit(other); break;
+					case ContactType.TriggerEnter:   targets[i].OnTriggerEnter(other); break;
+					case ContactType.TriggerExit:    targets[i].OnTriggerExit(other); break;
+				}
+			}
+		}
+
+	}
+
+	// Name registered with the engine once, looked up by handle afterwards
+	public struct EntityName
+	{
+		internal readonly uint Handle;
+
+		public EntityName(string name)
+		{
+			Handle = InternalCalls.Entity_GetNameHandle(name);
+		}
 	}
 
 }
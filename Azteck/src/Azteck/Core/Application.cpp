@@ -3,6 +3,7 @@
 #include "Azteck/Core/Application.h"
 #include "Azteck/Core/Log.h"
 #include "Azteck/Core/Input.h"
+#include "Azteck/Core/JobSystem.h"
 #include "Azteck/Renderer/Renderer.h"
 
 #include "Azteck/Scripting/ScriptEngine.h"
@@ -19,6 +20,7 @@ namespace Azteck
 		: _isRunning(true)
 		, _isMinimised(false)
 		, _lastFrameTime(0.0f)
+		, _frameCount(0)
 		, _spec(spec)
 	{
 		AZ_PROFILE_FUNCTION();
@@ -29,19 +31,35 @@ namespace Azteck
 		if (!_spec.workingDirectory.empty())
 			std::filesystem::current_path(_spec.workingDirectory);
 
-		_window = Window::create(WindowProps(_spec.name));
-		_window->setEventCallback(AZ_BIND_EVENT_FN(Application::onEvent));
+		if (_spec.headless)
+		{
+			RendererAPI::setAPI(RendererAPI::API::Headless);
+		}
+		else
+		{
+			_window = Window::create(WindowProps(_spec.name));
+			_window->setEventCallback(AZ_BIND_EVENT_FN(Application::onEvent));
+		}
 
+		JobSystem::init();
 		Renderer::init();
 
-		_imGuiLayer = new ImGuiLayer;
-		pushOverlay(_imGuiLayer);
+		if (_spec.headless)
+		{
+			_imGuiLayer = nullptr;
+		}
+		else
+		{
+			_imGuiLayer = new ImGuiLayer;
+			pushOverlay(_imGuiLayer);
+		}
 	}
 
 	Application::~Application()
 	{
 		ScriptEngine::shutdown();
 		Renderer::shutdown();
+		JobSystem::shutdown();
 	}
 
 	void Application::close()
@@ -132,9 +150,13 @@ namespace Azteck
 		{
 			AZ_PROFILE_SCOPE("Run loop");
 
-			float time = (float)glfwGetTime();
-			Timestep timestep = time - _lastFrameTime;
-			_lastFrameTime = time;
+			Timestep timestep = _spec.fixedTimestep;
+			if (_window)
+			{
+				float time = (float)glfwGetTime();
+				timestep = time - _lastFrameTime;
+				_lastFrameTime = time;
+			}
 
 			executeMainThreadQueue();
 
@@ -147,16 +169,24 @@ namespace Azteck
 						layer->onUpdate(timestep);
 				}
 
-				_imGuiLayer->begin();
+				if (_imGuiLayer)
 				{
-					AZ_PROFILE_SCOPE("Layer imGui rendering");
-					for (Layer* layer : _layerStack)
-						layer->onImGuiRender();
+					_imGuiLayer->begin();
+					{
+						AZ_PROFILE_SCOPE("Layer imGui rendering");
+						for (Layer* layer : _layerStack)
+							layer->onImGuiRender();
+					}
+					_imGuiLayer->end();
 				}
-				_imGuiLayer->end();
 			}
 
-			_window->onUpdate();
+			if (_window)
+				_window->onUpdate();
+
+			_frameCount++;
+			if (_spec.maxFrames != 0 && _frameCount >= _spec.maxFrames)
+				close();
 		}
 	}
 }
@@ -33,6 +33,13 @@ namespace Azteck
 		std::string name = "Azteck App";
 		std::string workingDirectory;
 
+		// Runs without a window, ImGui or GPU, layers are updated on a fixed clock
+		bool headless = false;
+		float fixedTimestep = 1.0f / 60.0f;
+
+		// Closes the application after this many frames, 0 runs until close is called
+		uint64_t maxFrames = 0;
+
 		ApplicationCommandLineArgs args;
 	};
 
@@ -51,6 +58,9 @@ namespace Azteck
 
 		inline ImGuiLayer* getImGuiLayer() const { return _imGuiLayer; }
 		inline Window& getWindow() const { return *_window; }
+		inline bool hasWindow() const { return _window != nullptr; }
+		inline bool isHeadless() const { return _spec.headless; }
+		inline uint64_t getFrameCount() const { return _frameCount; }
 
 		inline static Application& getInstance() { return *_instance; }
 		inline const ApplicationSpecification& getSpecification() const { return _spec; }
@@ -75,6 +85,7 @@ namespace Azteck
 		bool _isMinimised;
 		bool _isRunning;
 		float _lastFrameTime;
+		uint64_t _frameCount;
 
 		std::vector<std::function<void()>> _mainThreadQueue;
 		std::mutex _mainThreadQueueMutex;
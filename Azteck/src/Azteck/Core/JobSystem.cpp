@@ -0,0 +1,154 @@
+#include "azpch.h"
+#include "JobSystem.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Azteck
+{
+	struct JobSystemData
+	{
+		std::vector<std::thread> workers;
+
+		std::deque<std::function<void()>> jobs;
+		std::mutex jobsMutex;
+		std::condition_variable wakeCondition;
+		bool running = true;
+	};
+
+	static JobSystemData* _data = nullptr;
+
+	static void workerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(_data->jobsMutex);
+				_data->wakeCondition.wait(lock, []() { return !_data->running || !_data->jobs.empty(); });
+
+				if (_data->jobs.empty())
+					return;
+
+				job = std::move(_data->jobs.front());
+				_data->jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	// Lets a waiting thread help out instead of idling
+	static bool tryRunJob()
+	{
+		std::function<void()> job;
+		{
+			std::scoped_lock<std::mutex> lock(_data->jobsMutex);
+			if (_data->jobs.empty())
+				return false;
+
+			job = std::move(_data->jobs.front());
+			_data->jobs.pop_front();
+		}
+
+		job();
+		return true;
+	}
+
+	void JobSystem::init(uint32_t workerCount)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		AZ_CORE_ASSERT(!_data, "JobSystem already initialized");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		_data = new JobSystemData();
+		_data->workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+			_data->workers.emplace_back(workerLoop);
+
+		AZ_CORE_INFO("JobSystem started with {0} workers", workerCount);
+	}
+
+	void JobSystem::shutdown()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (!_data)
+			return;
+
+		{
+			std::scoped_lock<std::mutex> lock(_data->jobsMutex);
+			_data->running = false;
+		}
+		_data->wakeCondition.notify_all();
+
+		for (auto& worker : _data->workers)
+			worker.join();
+
+		delete _data;
+		_data = nullptr;
+	}
+
+	uint32_t JobSystem::getWorkerCount()
+	{
+		return _data ? (uint32_t)_data->workers.size() : 0;
+	}
+
+	uint32_t JobSystem::parallelFor(uint32_t count, uint32_t minPartitionSize, const RangeFunction& function)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (count == 0)
+			return 0;
+
+		minPartitionSize = std::max(minPartitionSize, 1u);
+		const uint32_t partitionCount = std::min(getMaxPartitions(), (count + minPartitionSize - 1) / minPartitionSize);
+
+		if (partitionCount <= 1)
+		{
+			function(0, count, 0);
+			return 1;
+		}
+
+		const uint32_t partitionSize = count / partitionCount;
+		const uint32_t remainder = count % partitionCount;
+
+		// The first partitions take one extra element each until the remainder is spent
+		auto runPartition = [&](uint32_t partition)
+		{
+			uint32_t begin = partition * partitionSize + std::min(partition, remainder);
+			uint32_t end = begin + partitionSize + (partition < remainder ? 1 : 0);
+			function(begin, end, partition);
+		};
+
+		std::atomic<uint32_t> remaining = partitionCount - 1;
+		{
+			std::scoped_lock<std::mutex> lock(_data->jobsMutex);
+			for (uint32_t partition = 1; partition < partitionCount; partition++)
+			{
+				_data->jobs.emplace_back([&runPartition, &remaining, partition]()
+					{
+						runPartition(partition);
+						remaining.fetch_sub(1, std::memory_order_release);
+					});
+			}
+		}
+		_data->wakeCondition.notify_all();
+
+		runPartition(0);
+
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!tryRunJob())
+				std::this_thread::yield();
+		}
+
+		return partitionCount;
+	}
+}
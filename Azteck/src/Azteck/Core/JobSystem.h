@@ -0,0 +1,27 @@
+#pragma once
+
+#include <functional>
+
+namespace Azteck
+{
+	// Fixed pool of worker threads. The calling thread takes part in every parallelFor,
+	// so it is safe to call before init or with no workers, the work then runs inline
+	class JobSystem
+	{
+	public:
+		using RangeFunction = std::function<void(uint32_t begin, uint32_t end, uint32_t partition)>;
+
+		// Zero workers picks one less than the hardware thread count
+		static void init(uint32_t workerCount = 0);
+		static void shutdown();
+
+		static uint32_t getWorkerCount();
+		// Upper bound of partitions a parallelFor splits into, workers plus the calling thread
+		static uint32_t getMaxPartitions() { return getWorkerCount() + 1; }
+
+		// Splits [0, count) into contiguous ranges of at least minPartitionSize elements and blocks until all of them ran.
+		// Partition indices are unique within a call and ordered like the ranges, so they can select per-partition output.
+		// Returns the number of partitions used
+		static uint32_t parallelFor(uint32_t count, uint32_t minPartitionSize, const RangeFunction& function);
+	};
+}
@@ -0,0 +1,144 @@
+#include "azpch.h"
+#include "ParticlePool.h"
+
+#include <atomic>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define AZ_PARTICLES_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		// Distinct xorshift seed per pool, so emitters created together don't spray identical patterns
+		static uint32_t nextParticleSeed()
+		{
+			static std::atomic<uint32_t> s_poolCounter = 0;
+
+			// Golden ratio step through the counter, then the murmur3 finalizer to spread the bits
+			uint32_t seed = (s_poolCounter.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B9u;
+			seed ^= seed >> 16;
+			seed *= 0x85EBCA6Bu;
+			seed ^= seed >> 13;
+			seed *= 0xC2B2AE35u;
+			seed ^= seed >> 16;
+
+			// xorshift never leaves a zero state
+			return seed ? seed : 0x9E3779B9u;
+		}
+	}
+
+	ParticlePool::ParticlePool(uint32_t capacity)
+		: _randomState(Utils::nextParticleSeed())
+	{
+		setCapacity(capacity);
+	}
+
+	void ParticlePool::setCapacity(uint32_t capacity)
+	{
+		_capacity = capacity;
+		_count = std::min(_count, capacity);
+
+		// Padded to whole SIMD lanes
+		size_t size = (capacity + 3) & ~3u;
+		_positionX.resize(size);
+		_positionY.resize(size);
+		_velocityX.resize(size);
+		_velocityY.resize(size);
+		_life.resize(size);
+		_inverseLifetime.resize(size);
+	}
+
+	void ParticlePool::emit(const ParticleProps& props, const glm::vec2& position, uint32_t count)
+	{
+		count = std::min(count, _capacity - _count);
+
+		for (uint32_t i = _count; i < _count + count; i++)
+		{
+			float lifetime = std::max(props.lifetime + props.lifetimeVariation * (random() - 0.5f), 0.001f);
+
+			_positionX[i] = position.x;
+			_positionY[i] = position.y;
+			_velocityX[i] = props.velocity.x + props.velocityVariation.x * (random() - 0.5f);
+			_velocityY[i] = props.velocity.y + props.velocityVariation.y * (random() - 0.5f);
+			_life[i] = lifetime;
+			_inverseLifetime[i] = 1.0f / lifetime;
+		}
+
+		_count += count;
+	}
+
+	void ParticlePool::update(float ts, const glm::vec2& acceleration)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		float* positionX = _positionX.data();
+		float* positionY = _positionY.data();
+		float* velocityX = _velocityX.data();
+		float* velocityY = _velocityY.data();
+		float* life = _life.data();
+
+		const float deltaVelocityX = acceleration.x * ts;
+		const float deltaVelocityY = acceleration.y * ts;
+
+		uint32_t i = 0;
+
+#ifdef AZ_PARTICLES_SSE
+		const __m128 timestep = _mm_set1_ps(ts);
+		const __m128 deltaX = _mm_set1_ps(deltaVelocityX);
+		const __m128 deltaY = _mm_set1_ps(deltaVelocityY);
+
+		for (; i + 4 <= _count; i += 4)
+		{
+			__m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), deltaX);
+			__m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + i), deltaY);
+			_mm_storeu_ps(velocityX + i, vx);
+			_mm_storeu_ps(velocityY + i, vy);
+
+			_mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(vx, timestep)));
+			_mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(vy, timestep)));
+
+			_mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), timestep));
+		}
+#endif
+
+		for (; i < _count; i++)
+		{
+			velocityX[i] += deltaVelocityX;
+			velocityY[i] += deltaVelocityY;
+			positionX[i] += velocityX[i] * ts;
+			positionY[i] += velocityY[i] * ts;
+			life[i] -= ts;
+		}
+
+		// Dead particles are replaced by the last alive one, so the order is not kept
+		for (uint32_t j = 0; j < _count;)
+		{
+			if (life[j] > 0.0f)
+			{
+				j++;
+				continue;
+			}
+
+			uint32_t last = --_count;
+			positionX[j] = positionX[last];
+			positionY[j] = positionY[last];
+			velocityX[j] = velocityX[last];
+			velocityY[j] = velocityY[last];
+			life[j] = life[last];
+			_inverseLifetime[j] = _inverseLifetime[last];
+		}
+	}
+
+	float ParticlePool::random()
+	{
+		// xorshift32
+		_randomState ^= _randomState << 13;
+		_randomState ^= _randomState >> 17;
+		_randomState ^= _randomState << 5;
+
+		return (_randomState >> 8) * (1.0f / 16777216.0f);
+	}
+}
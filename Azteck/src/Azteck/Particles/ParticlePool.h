@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Azteck
+{
+	struct ParticleProps
+	{
+		// Particles per second
+		float emissionRate = 100.0f;
+		uint32_t maxParticles = 10000;
+
+		float lifetime = 1.0f;
+		float lifetimeVariation = 0.25f;
+
+		glm::vec2 velocity{ 0.0f, 1.0f };
+		glm::vec2 velocityVariation{ 0.5f };
+		glm::vec2 acceleration{ 0.0f };
+
+		// Interpolated over the lifetime of a particle
+		glm::vec4 colorBegin{ 1.0f };
+		glm::vec4 colorEnd{ 1.0f, 1.0f, 1.0f, 0.0f };
+		float sizeBegin = 0.1f;
+		float sizeEnd = 0.0f;
+	};
+
+	// Structure of arrays particle storage, alive particles are always packed at the front
+	class ParticlePool
+	{
+	public:
+		ParticlePool(uint32_t capacity);
+
+		void setCapacity(uint32_t capacity);
+
+		void emit(const ParticleProps& props, const glm::vec2& position, uint32_t count);
+		void update(float ts, const glm::vec2& acceleration);
+		void clear() { _count = 0; }
+
+		uint32_t getCount() const { return _count; }
+		uint32_t getCapacity() const { return _capacity; }
+
+		const float* getPositionsX() const { return _positionX.data(); }
+		const float* getPositionsY() const { return _positionY.data(); }
+
+		// 0 for a new particle, 1 at the end of its life
+		float getAge(uint32_t index) const { return 1.0f - _life[index] * _inverseLifetime[index]; }
+
+	private:
+		float random();
+
+	private:
+		std::vector<float> _positionX;
+		std::vector<float> _positionY;
+		std::vector<float> _velocityX;
+		std::vector<float> _velocityY;
+		std::vector<float> _life;
+		std::vector<float> _inverseLifetime;
+
+		uint32_t _count = 0;
+		uint32_t _capacity = 0;
+
+		uint32_t _randomState;
+	};
+}
@@ -0,0 +1,48 @@
+#include "azpch.h"
+#include "Physics2DContactListener.h"
+
+#include "Azteck/Scene/Components.h"
+
+#include "box2d/b2_contact.h"
+#include "box2d/b2_fixture.h"
+
+namespace Azteck
+{
+	Physics2DContactListener::Physics2DContactListener(entt::registry& registry)
+		: _registry(registry)
+	{
+	}
+
+	void Physics2DContactListener::BeginContact(b2Contact* contact)
+	{
+		recordContact(contact, true);
+	}
+
+	void Physics2DContactListener::EndContact(b2Contact* contact)
+	{
+		recordContact(contact, false);
+	}
+
+	void Physics2DContactListener::recordContact(b2Contact* contact, bool begin)
+	{
+		b2Fixture* fixtureA = contact->GetFixtureA();
+		b2Fixture* fixtureB = contact->GetFixtureB();
+
+		auto entityA = static_cast<entt::entity>(fixtureA->GetUserData().pointer);
+		auto entityB = static_cast<entt::entity>(fixtureB->GetUserData().pointer);
+
+		// Contacts also end while an entity is being destroyed and its ID may already be gone
+		const auto* idA = _registry.try_get<IDComponent>(entityA);
+		const auto* idB = _registry.try_get<IDComponent>(entityB);
+		if (!idA || !idB)
+			return;
+
+		Contact2DEvent::Type type;
+		if (fixtureA->IsSensor() || fixtureB->IsSensor())
+			type = begin ? Contact2DEvent::Type::TriggerEnter : Contact2DEvent::Type::TriggerExit;
+		else
+			type = begin ? Contact2DEvent::Type::CollisionEnter : Contact2DEvent::Type::CollisionExit;
+
+		_events.push_back({ idA->id, idB->id, type });
+	}
+}
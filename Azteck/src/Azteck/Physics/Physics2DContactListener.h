@@ -0,0 +1,46 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include "Azteck/Core/UUID.h"
+
+#include "box2d/b2_world_callbacks.h"
+
+namespace Azteck
+{
+	struct Contact2DEvent
+	{
+		enum class Type : uint8_t
+		{
+			CollisionEnter = 0,
+			CollisionExit,
+			TriggerEnter,
+			TriggerExit
+		};
+
+		UUID entityA;
+		UUID entityB;
+		Type type;
+	};
+
+	// Box2D reports contacts while the world is locked,
+	// so they are only recorded here and handed out after the step
+	class Physics2DContactListener : public b2ContactListener
+	{
+	public:
+		Physics2DContactListener(entt::registry& registry);
+
+		void BeginContact(b2Contact* contact) override;
+		void EndContact(b2Contact* contact) override;
+
+		const std::vector<Contact2DEvent>& getEvents() const { return _events; }
+		void clear() { _events.clear(); }
+
+	private:
+		void recordContact(b2Contact* contact, bool begin);
+
+	private:
+		entt::registry& _registry;
+		std::vector<Contact2DEvent> _events;
+	};
+}
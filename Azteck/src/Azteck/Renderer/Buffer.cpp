@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Headless/HeadlessBuffer.h"
 
 namespace Azteck
 {
@@ -21,6 +22,11 @@ namespace Azteck
 			return createRef<OpenGLVertexBuffer>(size);
 		}
 
+		case RendererAPI::API::Headless:
+		{
+			return createRef<HeadlessVertexBuffer>(size);
+		}
+
 		default:
 		{
 			AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -44,6 +50,11 @@ namespace Azteck
 				return createRef<OpenGLVertexBuffer>(vertices, size);
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return createRef<HeadlessVertexBuffer>(vertices, size);
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -67,6 +78,11 @@ namespace Azteck
 				return createRef<OpenGLIndexBuffer>(indices, count);
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return createRef<HeadlessIndexBuffer>(indices, count);
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -8,11 +8,97 @@
 
 #include "MSDFData.h"
 
+#include "Azteck/Core/FileSystem.h"
+
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+
 namespace Azteck
 {
+	struct CharsetRange
+	{
+		uint32_t begin, end;
+	};
+
+	// From imgui_draw.cpp
+	static const CharsetRange charsetRanges[] =
+	{
+		{ 0x0020, 0x00FF }
+	};
+
+	static constexpr double fontEmSize = 40.0;
+	static constexpr double fontPixelRange = 2.0;
+	static constexpr double fontMiterLimit = 1.0;
+
+	namespace Utils
+	{
+		static const char* getFontCacheDirectory()
+		{
+			// TODO: make sure the assets directory is valid
+			return "assets/cache/font";
+		}
+
+		static void createFontCacheDirectoryIfNeeded()
+		{
+			std::string cacheDirectory = getFontCacheDirectory();
+			if (!std::filesystem::exists(cacheDirectory))
+				std::filesystem::create_directories(cacheDirectory);
+		}
+
+		// FNV-1a
+		static uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+
+			return hash;
+		}
+
+		static uint64_t kerningKey(uint32_t first, uint32_t second)
+		{
+			return ((uint64_t)first << 32) | second;
+		}
+	}
+
+	struct FontAtlasCacheHeader
+	{
+		static constexpr uint32_t Magic = 0x41465A41; // "AZFA"
+		static constexpr uint32_t Version = 2;
+		static constexpr uint32_t MaxSize = 16384;
+
+		uint32_t magic = Magic;
+		uint32_t version = Version;
+		uint64_t key = 0;
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t glyphCount = 0;
+		uint32_t kerningCount = 0;
+
+		FontMetrics metrics;
+	};
+
+	static Ref<Texture2D> createAtlasTexture(uint32_t width, uint32_t height, const uint8_t* pixels)
+	{
+		TextureSpecification spec;
+		spec.width = width;
+		spec.height = height;
+		spec.format = ImageFormat::RGB8;
+		spec.generateMips = false;
+
+		Ref<Texture2D> texture = Texture2D::create(spec);
+		texture->setData((void*)pixels, width * height * 3);
+		return texture;
+	}
+
 	template<typename T, typename S, int N, msdf_atlas::GeneratorFunction<S, N> GenFunc>
-	static Ref<Texture2D> createAndCacheAtlas(const std::string& fontName, float fontSize, const std::vector<msdf_atlas::GlyphGeometry>& glyphs,
-		const msdf_atlas::FontGeometry& fontGeometry, uint32_t width, uint32_t height)
+	static void generateAtlasBitmap(const std::vector<msdf_atlas::GlyphGeometry>& glyphs, uint32_t width, uint32_t height, std::vector<T>& outPixels)
 	{
 		msdf_atlas::GeneratorAttributes attributes;
 		attributes.config.overlapSupport = true;
@@ -24,21 +110,440 @@ namespace Azteck
 		generator.generate(glyphs.data(), (int)glyphs.size());
 
 		msdfgen::BitmapConstRef<T, N> bitmap = (msdfgen::BitmapConstRef<T, N>)generator.atlasStorage();
+		outPixels.assign(bitmap.pixels, bitmap.pixels + bitmap.width * bitmap.height * N);
+	}
 
-		TextureSpecification spec;
-		spec.width = bitmap.width;
-		spec.height = bitmap.height;
-		spec.format = ImageFormat::RGB8;
-		spec.generateMips = false;
+	// Generates glyphs that are not part of the prebuilt charset on a worker thread
+	// and packs them into fixed size RGBA pages using a shelf packer
+	class DynamicGlyphAtlas
+	{
+	public:
+		static constexpr uint32_t pageSize = 1024;
+		static constexpr uint32_t glyphPadding = 1;
 
-		Ref<Texture2D> texture = Texture2D::create(spec);
-		texture->setData((void*)bitmap.pixels, bitmap.width * bitmap.height * 3);
-		return texture;
-	}
+		struct GeneratedGlyph
+		{
+			uint32_t codepoint;
+			bool valid = false;
+
+			FontGlyph glyph;
+			uint32_t x = 0, y = 0;
+			uint32_t width = 0, height = 0;
+			std::vector<uint8_t> pixels;
+		};
+
+	public:
+		DynamicGlyphAtlas(const std::filesystem::path& filepath)
+			: _filepath(filepath.string())
+		{
+			_thread = std::thread([this]() { run(); });
+		}
+
+		~DynamicGlyphAtlas()
+		{
+			{
+				std::scoped_lock<std::mutex> lock(_mutex);
+				_running = false;
+			}
+
+			_condition.notify_one();
+			_thread.join();
+		}
+
+		void request(uint32_t codepoint)
+		{
+			{
+				std::scoped_lock<std::mutex> lock(_mutex);
+				_requests.push_back(codepoint);
+			}
+
+			_condition.notify_one();
+		}
+
+		bool hasResults() const { return _hasResults; }
+
+		void takeResults(std::vector<GeneratedGlyph>& outResults)
+		{
+			std::scoped_lock<std::mutex> lock(_mutex);
+			outResults.swap(_results);
+			_hasResults = false;
+		}
+
+	private:
+		void run()
+		{
+			// FreeType handles can't be shared between threads, so the worker opens the font itself
+			msdfgen::FreetypeHandle* ft = msdfgen::initializeFreetype();
+			msdfgen::FontHandle* font = ft ? msdfgen::loadFont(ft, _filepath.c_str()) : nullptr;
+
+			double geometryScale = 1.0;
+			msdfgen::FontMetrics metrics;
+			if (font && msdfgen::getFontMetrics(metrics, font) && metrics.emSize > 0.0)
+				geometryScale = 1.0 / metrics.emSize;
+
+			while (true)
+			{
+				uint32_t codepoint;
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_condition.wait(lock, [this]() { return !_running || !_requests.empty(); });
+
+					if (!_running)
+						break;
+
+					codepoint = _requests.front();
+					_requests.pop_front();
+				}
+
+				GeneratedGlyph result;
+				result.codepoint = codepoint;
+				if (font)
+					generate(font, geometryScale, result);
+
+				std::scoped_lock<std::mutex> lock(_mutex);
+				_results.push_back(std::move(result));
+				_hasResults = true;
+			}
+
+			if (font)
+				msdfgen::destroyFont(font);
+
+			if (ft)
+				msdfgen::deinitializeFreetype(ft);
+		}
+
+		void generate(msdfgen::FontHandle* font, double geometryScale, GeneratedGlyph& result)
+		{
+			msdf_atlas::GlyphGeometry glyphGeometry;
+			if (!glyphGeometry.load(font, geometryScale, (msdfgen::unicode_t)result.codepoint))
+				return;
+
+			result.valid = true;
+			result.glyph.advance = (float)glyphGeometry.getAdvance();
+
+			if (glyphGeometry.isWhitespace())
+				return;
+
+			glyphGeometry.edgeColoring(msdfgen::edgeColoringInkTrap, 3.0, 0);
+			glyphGeometry.wrapBox(fontEmSize, fontPixelRange / fontEmSize, fontMiterLimit);
+
+			int width, height;
+			glyphGeometry.getBoxSize(width, height);
+
+			if (!allocate((uint32_t)width, (uint32_t)height, result))
+			{
+				AZ_CORE_WARN("Dynamic font atlas is full, glyph {} is skipped", result.codepoint);
+				result.valid = false;
+				return;
+			}
+
+			glyphGeometry.placeBox((int)result.x, (int)result.y);
+
+			msdfgen::Bitmap<float, 3> bitmap(width, height);
+			msdf_atlas::GeneratorAttributes attributes;
+			attributes.config.overlapSupport = true;
+			attributes.scanlinePass = true;
+			msdf_atlas::msdfGenerator(bitmap, glyphGeometry, attributes);
+
+			// Pages are RGBA so that rows of any width are aligned for the upload
+			result.width = (uint32_t)width;
+			result.height = (uint32_t)height;
+			result.pixels.resize(result.width * result.height * 4);
+
+			uint8_t* pixel = result.pixels.data();
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					const float* source = bitmap(x, y);
+					*pixel++ = msdfgen::pixelFloatToByte(source[0]);
+					*pixel++ = msdfgen::pixelFloatToByte(source[1]);
+					*pixel++ = msdfgen::pixelFloatToByte(source[2]);
+					*pixel++ = 255;
+				}
+			}
+
+			double al, ab, ar, at;
+			glyphGeometry.getQuadAtlasBounds(al, ab, ar, at);
+
+			double pl, pb, pr, pt;
+			glyphGeometry.getQuadPlaneBounds(pl, pb, pr, pt);
+
+			const float texelSize = 1.0f / pageSize;
+			result.glyph.quadMin = { (float)pl, (float)pb };
+			result.glyph.quadMax = { (float)pr, (float)pt };
+			result.glyph.texCoordMin = glm::vec2((float)al, (float)ab) * texelSize;
+			result.glyph.texCoordMax = glm::vec2((float)ar, (float)at) * texelSize;
+		}
+
+		bool allocate(uint32_t width, uint32_t height, GeneratedGlyph& result)
+		{
+			if (width + glyphPadding > pageSize || height + glyphPadding > pageSize)
+				return false;
+
+			if (_shelfX + width + glyphPadding > pageSize)
+			{
+				_shelfX = 0;
+				_shelfY += _shelfHeight;
+				_shelfHeight = 0;
+			}
+
+			if (_shelfY + height + glyphPadding > pageSize)
+			{
+				if (_page + 1 >= Font::maxAtlasPages)
+					return false;
+
+				_page++;
+				_shelfX = 0;
+				_shelfY = 0;
+				_shelfHeight = 0;
+			}
+
+			result.glyph.page = _page;
+			result.x = _shelfX;
+			result.y = _shelfY;
+
+			_shelfX += width + glyphPadding;
+			_shelfHeight = std::max(_shelfHeight, height + glyphPadding);
+			return true;
+		}
+
+	private:
+		std::string _filepath;
+
+		std::thread _thread;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		bool _running = true;
+
+		std::deque<uint32_t> _requests;
+		std::vector<GeneratedGlyph> _results;
+		std::atomic<bool> _hasResults{ false };
+
+		// Only touched by the worker, page 0 is the prebuilt atlas
+		uint32_t _page = 1;
+		uint32_t _shelfX = 0;
+		uint32_t _shelfY = 0;
+		uint32_t _shelfHeight = 0;
+	};
 
 	Font::Font(const std::filesystem::path& filepath)
-		: _data(new MSDFData())
+		: _atlasPages(1)
 	{
+		AZ_PROFILE_FUNCTION();
+
+		ScopedBuffer fontData = FileSystem::readFileBinary(filepath);
+		if (!fontData)
+		{
+			AZ_CORE_ERROR("Failed to load font: {}", filepath.string());
+			return;
+		}
+
+		// The atlas only has to be generated again if the font or the generation settings change
+		uint64_t key = Utils::hashBytes(fontData.data(), fontData.size());
+		key = Utils::hashBytes(charsetRanges, sizeof(charsetRanges), key);
+		key = Utils::hashBytes(&fontEmSize, sizeof(fontEmSize), key);
+		key = Utils::hashBytes(&fontPixelRange, sizeof(fontPixelRange), key);
+
+		std::filesystem::path cachePath = std::filesystem::path(Utils::getFontCacheDirectory()) / fmt::format("{}-{:016x}.azfont", filepath.stem().string(), key);
+
+		if (loadAtlasCache(cachePath, key))
+		{
+			AZ_CORE_INFO("Loaded font atlas from cache: {}", cachePath.string());
+		}
+		else
+		{
+			std::vector<uint8_t> pixels;
+			generateAtlas(filepath, fontEmSize, pixels);
+
+			if (_atlasPages[0])
+				saveAtlasCache(cachePath, key, pixels.data());
+		}
+
+		_dynamicAtlasPath = filepath;
+	}
+
+	Font::~Font()
+	{
+	}
+
+	const FontGlyph* Font::getGlyph(uint32_t codepoint)
+	{
+		auto it = _glyphs.find(codepoint);
+		if (it != _glyphs.end())
+			return &it->second;
+
+		if (_dynamicAtlasPath.empty() || !_requestedGlyphs.insert(codepoint).second)
+			return nullptr;
+
+		if (!_dynamicAtlas)
+			_dynamicAtlas = createScope<DynamicGlyphAtlas>(_dynamicAtlasPath);
+
+		_dynamicAtlas->request(codepoint);
+		return nullptr;
+	}
+
+	void Font::updateDynamicGlyphs()
+	{
+		if (!_dynamicAtlas || !_dynamicAtlas->hasResults())
+			return;
+
+		AZ_PROFILE_FUNCTION();
+
+		std::vector<DynamicGlyphAtlas::GeneratedGlyph> results;
+		_dynamicAtlas->takeResults(results);
+
+		for (auto& result : results)
+		{
+			// Glyphs the font doesn't have stay in the requested set, so they are not generated again
+			if (!result.valid)
+				continue;
+
+			if (!result.pixels.empty())
+			{
+				uint32_t page = result.glyph.page;
+				if (page >= _atlasPages.size())
+					_atlasPages.resize(page + 1);
+
+				if (!_atlasPages[page])
+				{
+					TextureSpecification spec;
+					spec.width = DynamicGlyphAtlas::pageSize;
+					spec.height = DynamicGlyphAtlas::pageSize;
+					spec.format = ImageFormat::RGBA8;
+					spec.generateMips = false;
+
+					_atlasPages[page] = Texture2D::create(spec);
+
+					std::vector<uint8_t> clearData(spec.width * spec.height * 4, 0);
+					_atlasPages[page]->setData(clearData.data(), (uint32_t)clearData.size());
+				}
+
+				_atlasPages[page]->setSubData(result.pixels.data(), result.x, result.y, result.width, result.height);
+			}
+
+			_glyphs[result.codepoint] = result.glyph;
+		}
+
+		_glyphGeneration++;
+	}
+
+	float Font::getKerning(uint32_t first, uint32_t second) const
+	{
+		if (_kerning.empty())
+			return 0.0f;
+
+		auto it = _kerning.find(Utils::kerningKey(first, second));
+		if (it == _kerning.end())
+			return 0.0f;
+
+		return it->second;
+	}
+
+	bool Font::loadAtlasCache(const std::filesystem::path& cachePath, uint64_t key)
+	{
+		std::ifstream in(cachePath, std::ios::in | std::ios::binary);
+		if (!in.is_open())
+			return false;
+
+		FontAtlasCacheHeader header;
+		in.read((char*)&header, sizeof(header));
+
+		if (!in || header.magic != FontAtlasCacheHeader::Magic || header.version != FontAtlasCacheHeader::Version || header.key != key)
+			return false;
+
+		// The header drives every allocation below, so it has to describe exactly the bytes on disk
+		std::error_code error;
+		uint64_t fileSize = std::filesystem::file_size(cachePath, error);
+		uint64_t expectedSize = sizeof(header)
+			+ (uint64_t)header.glyphCount * (sizeof(uint32_t) + sizeof(FontGlyph))
+			+ (uint64_t)header.kerningCount * (sizeof(uint64_t) + sizeof(float))
+			+ (uint64_t)header.width * header.height * 3;
+
+		if (error || header.width == 0 || header.height == 0 || header.width > FontAtlasCacheHeader::MaxSize
+			|| header.height > FontAtlasCacheHeader::MaxSize || fileSize != expectedSize)
+		{
+			AZ_CORE_WARN("Font atlas cache is corrupted: {}", cachePath.string());
+			return false;
+		}
+
+		_metrics = header.metrics;
+
+		_glyphs.reserve(header.glyphCount);
+		for (uint32_t i = 0; i < header.glyphCount; i++)
+		{
+			uint32_t codepoint;
+			FontGlyph glyph;
+			in.read((char*)&codepoint, sizeof(codepoint));
+			in.read((char*)&glyph, sizeof(glyph));
+			_glyphs[codepoint] = glyph;
+		}
+
+		_kerning.reserve(header.kerningCount);
+		for (uint32_t i = 0; i < header.kerningCount; i++)
+		{
+			uint64_t pair;
+			float kerning;
+			in.read((char*)&pair, sizeof(pair));
+			in.read((char*)&kerning, sizeof(kerning));
+			_kerning[pair] = kerning;
+		}
+
+		std::vector<uint8_t> pixels((size_t)header.width * header.height * 3);
+		in.read((char*)pixels.data(), pixels.size());
+
+		if (!in)
+		{
+			AZ_CORE_WARN("Font atlas cache is corrupted: {}", cachePath.string());
+
+			_glyphs.clear();
+			_kerning.clear();
+			return false;
+		}
+
+		_atlasPages[0] = createAtlasTexture(header.width, header.height, pixels.data());
+		return true;
+	}
+
+	void Font::saveAtlasCache(const std::filesystem::path& cachePath, uint64_t key, const uint8_t* pixels) const
+	{
+		Utils::createFontCacheDirectoryIfNeeded();
+
+		std::ofstream out(cachePath, std::ios::out | std::ios::binary);
+		if (!out.is_open())
+		{
+			AZ_CORE_WARN("Could not write font atlas cache: {}", cachePath.string());
+			return;
+		}
+
+		FontAtlasCacheHeader header;
+		header.key = key;
+		header.width = _atlasPages[0]->getWidth();
+		header.height = _atlasPages[0]->getHeight();
+		header.glyphCount = (uint32_t)_glyphs.size();
+		header.kerningCount = (uint32_t)_kerning.size();
+		header.metrics = _metrics;
+		out.write((const char*)&header, sizeof(header));
+
+		for (const auto& [codepoint, glyph] : _glyphs)
+		{
+			out.write((const char*)&codepoint, sizeof(codepoint));
+			out.write((const char*)&glyph, sizeof(glyph));
+		}
+
+		for (const auto& [pair, kerning] : _kerning)
+		{
+			out.write((const char*)&pair, sizeof(pair));
+			out.write((const char*)&kerning, sizeof(kerning));
+		}
+
+		out.write((const char*)pixels, (size_t)header.width * header.height * 3);
+	}
+
+	void Font::generateAtlas(const std::filesystem::path& filepath, double emSize, std::vector<uint8_t>& outPixels)
+	{
+		AZ_PROFILE_FUNCTION();
+
 		msdfgen::FreetypeHandle* ft = msdfgen::initializeFreetype();
 		AZ_CORE_ASSERT(ft, "Freetype is not initialized");
 
@@ -48,20 +553,10 @@ namespace Azteck
 		if (!font)
 		{
 			AZ_CORE_ERROR("Failed to load font: {}", fileString);
+			msdfgen::deinitializeFreetype(ft);
 			return;
 		}
 
-		struct CharsetRange
-		{
-			uint32_t begin, end;
-		};
-
-		// From imgui_draw.cpp
-		static const CharsetRange charsetRanges[] =
-		{
-			{ 0x0020, 0x00FF }
-		};
-
 		msdf_atlas::Charset charset;
 		for (CharsetRange range : charsetRanges)
 		{
@@ -69,20 +564,20 @@ namespace Azteck
 				charset.add(c);
 		}
 
+		MSDFData data;
+
 		double fontScale = 1.0;
-		_data->fontGeometry = msdf_atlas::FontGeometry(&_data->glyphs);
-		int glyphsLoaded = _data->fontGeometry.loadCharset(font, fontScale, charset);
+		data.fontGeometry = msdf_atlas::FontGeometry(&data.glyphs);
+		int glyphsLoaded = data.fontGeometry.loadCharset(font, fontScale, charset);
 		AZ_CORE_INFO("Loaded {} glyphs from font (out of {})", glyphsLoaded, charset.size());
 
-		double emSize = 40.0;
-
 		msdf_atlas::TightAtlasPacker atlasPacker;
 		// atlasPacker.setDimensionsConstraint()
-		atlasPacker.setPixelRange(2.0);
-		atlasPacker.setMiterLimit(1.0);
+		atlasPacker.setPixelRange(fontPixelRange);
+		atlasPacker.setMiterLimit(fontMiterLimit);
 		atlasPacker.setPadding(0);
 		atlasPacker.setScale(emSize);
-		int remaining = atlasPacker.pack(_data->glyphs.data(), (int)_data->glyphs.size());
+		int remaining = atlasPacker.pack(data.glyphs.data(), (int)data.glyphs.size());
 		AZ_CORE_ASSERT(remaining == 0, "");
 
 		int width, height;
@@ -99,32 +594,64 @@ namespace Azteck
 		bool expensiveColoring = false;
 		if (expensiveColoring)
 		{
-			msdf_atlas::Workload([&glyphs = _data->glyphs, &coloringSeed](int i, int threadNo) -> bool {
+			msdf_atlas::Workload([&glyphs = data.glyphs, &coloringSeed](int i, int threadNo) -> bool {
 				unsigned long long glyphSeed = (LCG_MULTIPLIER * (coloringSeed ^ i) + LCG_INCREMENT) * !!coloringSeed;
 				glyphs[i].edgeColoring(msdfgen::edgeColoringInkTrap, DEFAULT_ANGLE_THRESHOLD, glyphSeed);
 				return true;
-				}, _data->glyphs.size()).finish(THREAD_COUNT);
+				}, data.glyphs.size()).finish(THREAD_COUNT);
 		}
 		else {
 			unsigned long long glyphSeed = coloringSeed;
-			for (msdf_atlas::GlyphGeometry& glyph : _data->glyphs)
+			for (msdf_atlas::GlyphGeometry& glyph : data.glyphs)
 			{
 				glyphSeed *= LCG_MULTIPLIER;
 				glyph.edgeColoring(msdfgen::edgeColoringInkTrap, DEFAULT_ANGLE_THRESHOLD, glyphSeed);
 			}
 		}
 
-		_atlasTexture = createAndCacheAtlas<uint8_t, float, 3, msdf_atlas::msdfGenerator>("Test", (float)emSize, _data->glyphs, _data->fontGeometry, width, height);
+		generateAtlasBitmap<uint8_t, float, 3, msdf_atlas::msdfGenerator>(data.glyphs, width, height, outPixels);
+		_atlasPages[0] = createAtlasTexture(width, height, outPixels.data());
+
+		// Keep only what text layout needs, so a cached atlas doesn't depend on msdf-atlas-gen types
+		const auto& metrics = data.fontGeometry.getMetrics();
+		_metrics.lineHeight = (float)metrics.lineHeight;
+		_metrics.ascenderY = (float)metrics.ascenderY;
+		_metrics.descenderY = (float)metrics.descenderY;
+
+		const glm::vec2 texelSize(1.0f / width, 1.0f / height);
+
+		std::unordered_map<int, uint32_t> glyphIndexToCodepoint;
+		for (const auto& glyphGeometry : data.glyphs)
+		{
+			double al, ab, ar, at;
+			glyphGeometry.getQuadAtlasBounds(al, ab, ar, at);
+
+			double pl, pb, pr, pt;
+			glyphGeometry.getQuadPlaneBounds(pl, pb, pr, pt);
+
+			FontGlyph& glyph = _glyphs[glyphGeometry.getCodepoint()];
+			glyph.quadMin = { (float)pl, (float)pb };
+			glyph.quadMax = { (float)pr, (float)pt };
+			glyph.texCoordMin = glm::vec2((float)al, (float)ab) * texelSize;
+			glyph.texCoordMax = glm::vec2((float)ar, (float)at) * texelSize;
+			glyph.advance = (float)glyphGeometry.getAdvance();
+
+			glyphIndexToCodepoint[glyphGeometry.getIndex()] = glyphGeometry.getCodepoint();
+		}
+
+		for (const auto& [pair, kerning] : data.fontGeometry.getKerning())
+		{
+			auto first = glyphIndexToCodepoint.find(pair.first);
+			auto second = glyphIndexToCodepoint.find(pair.second);
+
+			if (first != glyphIndexToCodepoint.end() && second != glyphIndexToCodepoint.end())
+				_kerning[Utils::kerningKey(first->second, second->second)] = (float)kerning;
+		}
 
 		msdfgen::destroyFont(font);
 		msdfgen::deinitializeFreetype(ft);
 	}
 
-	Font::~Font()
-	{
-		delete _data;
-	}
-
 	Ref<Font> Font::getDefault()
 	{
 		static Ref<Font> defaultFont;
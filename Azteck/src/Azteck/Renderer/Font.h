@@ -2,27 +2,82 @@
 
 #include <filesystem>
 
+#include <glm/glm.hpp>
+
 #include "Azteck/Core/Core.h"
 #include "Azteck/Renderer/Texture.h"
 
 namespace Azteck
 {
-	struct MSDFData;
+	struct FontGlyph
+	{
+		// Plane bounds in font units
+		glm::vec2 quadMin;
+		glm::vec2 quadMax;
+
+		// Normalized atlas coordinates
+		glm::vec2 texCoordMin;
+		glm::vec2 texCoordMax;
+
+		float advance;
+
+		// Atlas page the glyph lives in, 0 is the prebuilt atlas
+		uint32_t page = 0;
+	};
+
+	struct FontMetrics
+	{
+		float lineHeight = 0.0f;
+		float ascenderY = 0.0f;
+		float descenderY = 0.0f;
+	};
+
+	class DynamicGlyphAtlas;
 
 	class Font
 	{
+	public:
+		static constexpr uint32_t maxAtlasPages = 8;
+
 	public:
 		Font(const std::filesystem::path& filepath);
 		~Font();
 
-		const MSDFData* getMSDFData() const { return _data; }
-		Ref<Texture2D> getAtlasTexture() const { return _atlasTexture; }
+		// Glyphs outside of the prebuilt charset are generated in the background on first use,
+		// until then nullptr is returned
+		const FontGlyph* getGlyph(uint32_t codepoint);
+		float getKerning(uint32_t first, uint32_t second) const;
+		const FontMetrics& getMetrics() const { return _metrics; }
+
+		Ref<Texture2D> getAtlasTexture(uint32_t page = 0) const { return _atlasPages[page]; }
+
+		// Uploads glyphs generated since the last call, has to be called on the render thread
+		void updateDynamicGlyphs();
+
+		// Incremented every time new glyphs become available
+		uint32_t getGlyphGeneration() const { return _glyphGeneration; }
 
 		static Ref<Font> getDefault();
 
 	private:
-		MSDFData* _data;
-		Ref<Texture2D> _atlasTexture;
+		bool loadAtlasCache(const std::filesystem::path& cachePath, uint64_t key);
+		void saveAtlasCache(const std::filesystem::path& cachePath, uint64_t key, const uint8_t* pixels) const;
+
+		void generateAtlas(const std::filesystem::path& filepath, double emSize, std::vector<uint8_t>& outPixels);
+
+	private:
+		std::unordered_map<uint32_t, FontGlyph> _glyphs;
+		std::unordered_map<uint64_t, float> _kerning;
+		FontMetrics _metrics;
+
+		std::vector<Ref<Texture2D>> _atlasPages;
+
+		// Started on the first missing glyph, most fonts never need the worker thread.
+		// The path stays empty if the font failed to load
+		std::filesystem::path _dynamicAtlasPath;
+		Scope<DynamicGlyphAtlas> _dynamicAtlas;
+		std::unordered_set<uint32_t> _requestedGlyphs;
+		uint32_t _glyphGeneration = 0;
 	};
 
 }
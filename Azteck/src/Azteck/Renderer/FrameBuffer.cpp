@@ -3,6 +3,7 @@
 #include "FrameBuffer.h"
 
 #include "Platform/OpenGL/OpenGLFrameBuffer.h"
+#include "Platform/Headless/HeadlessFrameBuffer.h"
 #include "Renderer.h"
 
 namespace Azteck
@@ -22,6 +23,11 @@ namespace Azteck
 			return createRef<OpenGLFrameBuffer>(spec);
 		}
 
+		case RendererAPI::API::Headless:
+		{
+			return createRef<HeadlessFrameBuffer>(spec);
+		}
+
 		default:
 		{
 			AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
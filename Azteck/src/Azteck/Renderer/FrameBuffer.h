@@ -62,6 +62,15 @@ namespace Azteck
 		virtual void resize(uint32_t width, uint32_t height) = 0;
 		virtual int readPixel(uint32_t attachmentIndex, int x, int y) = 0;
 
+		// Queues a read of one pixel without waiting for the GPU, the value shows up in
+		// getAsyncPixel one or two frames later
+		virtual void readPixelAsync(uint32_t attachmentIndex, int x, int y) = 0;
+		// Latest completed async read, false until the first one finished
+		virtual bool getAsyncPixel(int& outValue) = 0;
+
+		// Copies a whole RGBA8 attachment, bottom row first. Waits for the GPU
+		virtual void readColorAttachment(uint32_t attachmentIndex, void* outData, uint32_t size) = 0;
+
 		virtual void clearAttachment(uint32_t attachmentIndex, int value) = 0;
 
 		virtual const FrameBufferSpecification& getSpecification() const = 0;
@@ -1,9 +1,7 @@
 #include "azpch.h"
 #include "RenderCommand.h"
 
-#include "Platform/OpenGL/OpenGLRendererAPI.h"
-
 namespace Azteck
 {
-	Scope<RendererAPI> RenderCommand::_rendererAPI = RendererAPI::create();
+	Scope<RendererAPI> RenderCommand::_rendererAPI;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace Azteck
 	public:
 		inline static void init()
 		{
+			_rendererAPI = RendererAPI::create();
 			_rendererAPI->init();
 		}
 
@@ -9,55 +9,11 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-#include "MSDFData.h"
+#include "Renderer2DVertices.h"
+#include "TextLayout.h"
 
 namespace Azteck
 {
-	struct QuadVertex
-	{
-		glm::vec3 position;
-		glm::vec4 color;
-		glm::vec2 texCoord;
-		float texIndex;
-		float tilingFactor;
-
-		// Editor only
-		int entityID = -1;
-	};
-
-	struct CircleVertex
-	{
-		glm::vec3 worldPosition;
-		glm::vec3 localPosition;
-		glm::vec4 color;
-		float thickness;
-		float fade;
-
-		// Editor only
-		int entityID = -1;
-	};
-
-	struct LineVertex
-	{
-		glm::vec3 position;
-		glm::vec4 color;
-
-		// Editor only
-		int entityID = -1;
-	};
-
-	struct TextVertex
-	{
-		glm::vec3 position;
-		glm::vec4 color;
-		glm::vec2 texCoord;
-
-		// TODO: bg color for outline/bg
-
-		// Editor-only
-		int entityID = -1;
-	};
-
 	struct Renderer2DData
 	{
 		static const uint32_t maxQuads = 10000;
@@ -99,7 +55,9 @@ namespace Azteck
 		std::array<Ref<Texture2D>, maxTextureSlots> textureSlots;
 		uint32_t textureSlotIndex = 1;
 
-		Ref<Texture2D> fontAtlasTexture;
+		// Font atlases use their own slots since text is drawn with a separate shader
+		std::array<Ref<Texture2D>, maxTextureSlots> fontAtlasSlots;
+		uint32_t fontAtlasSlotIndex = 0;
 
 		const glm::vec4 quadVertexPositions[4] = {
 			{ -0.5f, -0.5f, 0.0f, 1.0f },
@@ -115,6 +73,19 @@ namespace Azteck
 			{ 0.0f, 1.0f }
 		};
 
+		// Layouts of strings drawn through the immediate drawString, reused while the same
+		// string keeps being drawn so it isn't decoded and laid out every frame
+		struct TextRun
+		{
+			std::string text;
+			TextLayout layout;
+			uint64_t lastUsedFrame = 0;
+		};
+
+		static const uint32_t textRunLifetime = 120;
+		std::unordered_map<uint64_t, TextRun> textRuns;
+		uint64_t frameIndex = 0;
+
 		Renderer2D::Statistics stats;
 
 		struct CameraData
@@ -128,6 +99,14 @@ namespace Azteck
 
 	static Renderer2DData _data;
 
+	class StaticBatch2D
+	{
+	public:
+		Ref<VertexArray> vertexArray;
+		std::vector<Ref<Texture2D>> textures;
+		uint32_t quadCount = 0;
+	};
+
 	void Renderer2D::init()
 	{
 		AZ_PROFILE_FUNCTION();
@@ -193,6 +172,18 @@ namespace Azteck
 		AZ_PROFILE_FUNCTION();
 
 		flush();
+
+		_data.frameIndex++;
+		if (_data.frameIndex % Renderer2DData::textRunLifetime == 0)
+		{
+			for (auto it = _data.textRuns.begin(); it != _data.textRuns.end();)
+			{
+				if (_data.frameIndex - it->second.lastUsedFrame > Renderer2DData::textRunLifetime)
+					it = _data.textRuns.erase(it);
+				else
+					it++;
+			}
+		}
 	}
 
 	void Renderer2D::flush()
@@ -245,7 +236,8 @@ namespace Azteck
 			uint32_t dataSize = (uint32_t)((uint8_t*)_data.textVertexBufferPtr - (uint8_t*)_data.textVertexBufferBase);
 			_data.textVertexBuffer->setData(_data.textVertexBufferBase, dataSize);
 
-			_data.fontAtlasTexture->bind(0);
+			for (uint32_t i = 0; i < _data.fontAtlasSlotIndex; i++)
+				_data.fontAtlasSlots[i]->bind(i);
 
 			_data.textShader->bind();
 			RenderCommand::drawIndexed(_data.textVertexArray, _data.textIndexCount);
@@ -373,124 +365,332 @@ namespace Azteck
 			drawQuad(transform, src.color, entityID);
 	}
 
-	void Renderer2D::drawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int entityID)
+	void Renderer2D::buildParticleVertices(const ParticlePool& pool, const ParticleProps& props, float z, int entityID, std::vector<QuadVertex>& outVertices)
 	{
-		const auto& fontGeometry = font->getMSDFData()->fontGeometry;
-		const auto& metrics = fontGeometry.getMetrics();
-		Ref<Texture2D> fontAtlas = font->getAtlasTexture();
+		static const glm::vec2 texCoords[4] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
 
-		_data.fontAtlasTexture = fontAtlas;
+		size_t offset = outVertices.size();
+		outVertices.resize(offset + (size_t)pool.getCount() * 4);
+		QuadVertex* vertex = outVertices.data() + offset;
 
-		double x = 0.0;
-		double y = 0.0;
+		const float* positionX = pool.getPositionsX();
+		const float* positionY = pool.getPositionsY();
 
-		const float spaceGlyphAdvance = fontGeometry.getGlyph(' ')->getAdvance();
+		for (uint32_t i = 0; i < pool.getCount(); i++)
+		{
+			float age = pool.getAge(i);
+			glm::vec4 color = glm::mix(props.colorBegin, props.colorEnd, age);
+			float halfSize = 0.5f * glm::mix(props.sizeBegin, props.sizeEnd, age);
+
+			const float x = positionX[i];
+			const float y = positionY[i];
+			const glm::vec3 positions[4] = {
+				{ x - halfSize, y - halfSize, z },
+				{ x + halfSize, y - halfSize, z },
+				{ x + halfSize, y + halfSize, z },
+				{ x - halfSize, y + halfSize, z }
+			};
+
+			for (size_t j = 0; j < 4; j++)
+			{
+				vertex->position = positions[j];
+				vertex->color = color;
+				vertex->texCoord = texCoords[j];
+				vertex->texIndex = 0.0f; // White texture
+				vertex->tilingFactor = 1.0f;
+				vertex->entityID = entityID;
+				vertex++;
+			}
+		}
+	}
 
-		const double fsScale = 1.0 / (metrics.ascenderY - metrics.descenderY);
+	void Renderer2D::drawQuadVertices(const QuadVertex* vertices, uint32_t quadCount)
+	{
+		AZ_PROFILE_FUNCTION();
 
-		for (size_t i = 0; i < string.size(); i++)
+		uint32_t written = 0;
+		while (written < quadCount)
 		{
-			char character = string[i];
-			if (character == '\r')
-				continue;
+			if (_data.quadIndexCount >= _data.maxIndices)
+				nextBatch();
+
+			uint32_t freeQuads = (_data.maxIndices - _data.quadIndexCount) / 6;
+			uint32_t count = std::min(freeQuads, quadCount - written);
+
+			memcpy(_data.quadVertexBufferPtr, vertices + (size_t)written * 4, (size_t)count * 4 * sizeof(QuadVertex));
+			_data.quadVertexBufferPtr += count * 4;
+			_data.quadIndexCount += count * 6;
+			written += count;
+		}
+
+		_data.stats.quadCount += quadCount;
+	}
+
+	void Renderer2D::createStaticBatches(const std::vector<StaticQuad>& quads, std::vector<Ref<StaticBatch2D>>& outBatches)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		outBatches.clear();
+
+		std::vector<QuadVertex> vertices;
+		std::vector<Ref<Texture2D>> textures = { _data.whiteTexture };
 
-			if (character == '\n')
+		auto finishBatch = [&]()
+		{
+			if (vertices.empty())
+				return;
+
+			Ref<StaticBatch2D> batch = createRef<StaticBatch2D>();
+			batch->textures = textures;
+			batch->quadCount = (uint32_t)(vertices.size() / 4);
+
+			Ref<VertexBuffer> vertexBuffer = VertexBuffer::create((float*)vertices.data(), (uint32_t)(vertices.size() * sizeof(QuadVertex)));
+			vertexBuffer->setLayout(_data.quadVertexBuffer->getLayout());
+
+			batch->vertexArray = VertexArray::create();
+			batch->vertexArray->addVertexBuffer(vertexBuffer);
+			batch->vertexArray->setIndexBuffer(_data.quadVertexArray->getIndexBuffer());
+
+			outBatches.push_back(batch);
+
+			vertices.clear();
+			textures.resize(1);
+		};
+
+		for (const auto& quad : quads)
+		{
+			const Ref<Texture2D>& texture = quad.texture ? quad.texture : _data.whiteTexture;
+
+			// Finishing a batch resets the texture slots, so it has to happen before the lookup
+			if (vertices.size() >= Renderer2DData::maxVertices)
+				finishBatch();
+
+			auto it = std::find_if(textures.begin(), textures.end(), [&texture](const Ref<Texture2D>& other) { return *other == *texture; });
+			if (it == textures.end() && textures.size() >= Renderer2DData::maxTextureSlots)
 			{
-				x = 0;
-				y -= fsScale * metrics.lineHeight + textParams.lineSpacing;
-				continue;
+				finishBatch();
+				it = std::find_if(textures.begin(), textures.end(), [&texture](const Ref<Texture2D>& other) { return *other == *texture; });
 			}
 
-			if (character == ' ')
+			float textureIndex;
+			if (it != textures.end())
 			{
-				float advance = spaceGlyphAdvance;
-				if (i < string.size() - 1)
-				{
-					char nextCharacter = string[i + 1];
-					double dAdvance;
-					fontGeometry.getAdvance(dAdvance, character, nextCharacter);
-					advance = (float)dAdvance;
-				}
-
-				x += fsScale * advance + textParams.kerning;
-				continue;
+				textureIndex = (float)(it - textures.begin());
+			}
+			else
+			{
+				textureIndex = (float)textures.size();
+				textures.push_back(texture);
 			}
 
-			if (character == '\t')
+			const float tilingFactor = quad.texture ? quad.tilingFactor : 1.0f;
+			for (size_t i = 0; i < 4; i++)
 			{
-				x += 4.0f * (fsScale * spaceGlyphAdvance + textParams.kerning);
-				continue;
+				QuadVertex& vertex = vertices.emplace_back();
+				vertex.position = quad.transform * _data.quadVertexPositions[i];
+				vertex.color = quad.color;
+				vertex.texCoord = glm::mix(quad.texCoordMin, quad.texCoordMax, _data.quadTexCoords[i]);
+				vertex.texIndex = textureIndex;
+				vertex.tilingFactor = tilingFactor;
+				vertex.entityID = quad.entityID;
 			}
+		}
+
+		finishBatch();
+	}
 
-			auto glyph = fontGeometry.getGlyph(character);
+	void Renderer2D::drawStaticBatch(const Ref<StaticBatch2D>& batch)
+	{
+		for (uint32_t i = 0; i < (uint32_t)batch->textures.size(); i++)
+			batch->textures[i]->bind(i);
 
-			if (!glyph)
-				glyph = fontGeometry.getGlyph('?');
+		_data.quadShader->bind();
+		RenderCommand::drawIndexed(batch->vertexArray, batch->quadCount * 6);
 
-			if (!glyph)
-				return;
+		_data.stats.drawCalls++;
+		_data.stats.quadCount += batch->quadCount;
+	}
+
+	void Renderer2D::drawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int entityID)
+	{
+		font->updateDynamicGlyphs();
+
+		uint64_t key = std::hash<std::string>()(string);
+		key ^= std::hash<const void*>()(font.get()) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+		key ^= std::hash<float>()(textParams.kerning) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+		key ^= std::hash<float>()(textParams.lineSpacing) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+
+		// A colliding string just replaces the run
+		Renderer2DData::TextRun& run = _data.textRuns[key];
+		if (run.text != string)
+		{
+			run.text = string;
+			run.layout.invalidate();
+		}
+
+		if (!run.layout.isValid(font, textParams.kerning, textParams.lineSpacing))
+			run.layout.build(string, font, textParams.kerning, textParams.lineSpacing);
+
+		run.lastUsedFrame = _data.frameIndex;
+		drawString(run.layout, transform, textParams.color, entityID);
+	}
+
+	void Renderer2D::drawString(const glm::mat4& transform, TextComponent& component, int entityID)
+	{
+		component.fontAsset->updateDynamicGlyphs();
+
+		TextLayout& layout = component.layout;
+		if (!layout.isValid(component.fontAsset, component.kerning, component.lineSpacing))
+			layout.build(component.textString, component.fontAsset, component.kerning, component.lineSpacing);
+
+		drawString(layout, transform, component.color, entityID);
+	}
+
+	void Renderer2D::drawString(TextLayout& layout, const glm::mat4& transform, const glm::vec4& color, int entityID)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		const auto& glyphs = layout.getGlyphs();
+		if (glyphs.empty())
+			return;
+
+		// A run that fits in a single batch is never split
+		size_t vertexCount = glyphs.size() * 4;
+		size_t usedVertices = _data.textVertexBufferPtr - _data.textVertexBufferBase;
+		if (vertexCount <= Renderer2DData::maxVertices && usedVertices + vertexCount > Renderer2DData::maxVertices)
+			nextBatch();
+
+		// Glyph quads only have to be transformed again when the text moved,
+		// otherwise just the glyphs appended since the last draw are
+		if (layout._verticesTransform != transform || layout._verticesColor != color || layout._verticesEntityID != entityID)
+			layout._verticesGlyphCount = 0;
+
+		bindFontAtlasPages(layout, 0);
+
+		if (layout._verticesGlyphCount < glyphs.size())
+		{
+			layout._vertices.resize(vertexCount);
+			TextVertex* vertex = layout._vertices.data() + layout._verticesGlyphCount * 4;
 
-			double al, ab, ar, at;
-			glyph->getQuadAtlasBounds(al, ab, ar, at);
-			glm::vec2 texCoordMin((float)al, (float)ab);
-			glm::vec2 texCoordMax((float)ar, (float)at);
-
-			double pl, pb, pr, pt;
-			glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-			glm::vec2 quadMin((float)pl, (float)pb);
-			glm::vec2 quadMax((float)pr, (float)pt);
-
-			quadMin *= fsScale, quadMax *= fsScale;
-			quadMin += glm::vec2(x, y);
-			quadMax += glm::vec2(x, y);
-
-			float texelWidth = 1.0f / fontAtlas->getWidth();
-			float texelHeight = 1.0f / fontAtlas->getHeight();
-			texCoordMin *= glm::vec2(texelWidth, texelHeight);
-			texCoordMax *= glm::vec2(texelWidth, texelHeight);
-
-			// render here
-			_data.textVertexBufferPtr->position = transform * glm::vec4(quadMin, 0.0f, 1.0f);
-			_data.textVertexBufferPtr->color = textParams.color;
-			_data.textVertexBufferPtr->texCoord = texCoordMin;
-			_data.textVertexBufferPtr->entityID = entityID; // TODO
-			_data.textVertexBufferPtr++;
-
-			_data.textVertexBufferPtr->position = transform * glm::vec4(quadMin.x, quadMax.y, 0.0f, 1.0f);
-			_data.textVertexBufferPtr->color = textParams.color;
-			_data.textVertexBufferPtr->texCoord = { texCoordMin.x, texCoordMax.y };
-			_data.textVertexBufferPtr->entityID = entityID; // TODO
-			_data.textVertexBufferPtr++;
-
-			_data.textVertexBufferPtr->position = transform * glm::vec4(quadMax, 0.0f, 1.0f);
-			_data.textVertexBufferPtr->color = textParams.color;
-			_data.textVertexBufferPtr->texCoord = texCoordMax;
-			_data.textVertexBufferPtr->entityID = entityID; // TODO
-			_data.textVertexBufferPtr++;
-
-			_data.textVertexBufferPtr->position = transform * glm::vec4(quadMax.x, quadMin.y, 0.0f, 1.0f);
-			_data.textVertexBufferPtr->color = textParams.color;
-			_data.textVertexBufferPtr->texCoord = { texCoordMax.x, texCoordMin.y };
-			_data.textVertexBufferPtr->entityID = entityID; // TODO
-			_data.textVertexBufferPtr++;
-
-			_data.textIndexCount += 6;
-			_data.stats.quadCount++;
-
-			if (i < string.size() - 1)
+			for (size_t i = layout._verticesGlyphCount; i < glyphs.size(); i++)
 			{
-				double advance = glyph->getAdvance();
-				char nextCharacter = string[i + 1];
-				fontGeometry.getAdvance(advance, character, nextCharacter);
+				const auto& glyph = glyphs[i];
+				float texIndex = layout._verticesTexIndices[glyph.page];
+
+				vertex->position = transform * glm::vec4(glyph.quadMin, 0.0f, 1.0f);
+				vertex->color = color;
+				vertex->texCoord = glyph.texCoordMin;
+				vertex->texIndex = texIndex;
+				vertex->entityID = entityID;
+				vertex++;
+
+				vertex->position = transform * glm::vec4(glyph.quadMin.x, glyph.quadMax.y, 0.0f, 1.0f);
+				vertex->color = color;
+				vertex->texCoord = { glyph.texCoordMin.x, glyph.texCoordMax.y };
+				vertex->texIndex = texIndex;
+				vertex->entityID = entityID;
+				vertex++;
+
+				vertex->position = transform * glm::vec4(glyph.quadMax, 0.0f, 1.0f);
+				vertex->color = color;
+				vertex->texCoord = glyph.texCoordMax;
+				vertex->texIndex = texIndex;
+				vertex->entityID = entityID;
+				vertex++;
+
+				vertex->position = transform * glm::vec4(glyph.quadMax.x, glyph.quadMin.y, 0.0f, 1.0f);
+				vertex->color = color;
+				vertex->texCoord = { glyph.texCoordMax.x, glyph.texCoordMin.y };
+				vertex->texIndex = texIndex;
+				vertex->entityID = entityID;
+				vertex++;
+			}
+
+			layout._verticesTransform = transform;
+			layout._verticesColor = color;
+			layout._verticesEntityID = entityID;
+			layout._verticesGlyphCount = glyphs.size();
+		}
 
-				x += fsScale * advance + textParams.kerning;
+		// Runs larger than the vertex buffer continue in the following batches
+		bool split = false;
+		size_t offset = 0;
+		while (offset < vertexCount)
+		{
+			size_t space = Renderer2DData::maxVertices - (_data.textVertexBufferPtr - _data.textVertexBufferBase);
+			if (space == 0)
+			{
+				nextBatch();
+				bindFontAtlasPages(layout, offset / 4);
+				split = true;
+				continue;
 			}
+
+			size_t count = std::min(space, vertexCount - offset);
+			memcpy(_data.textVertexBufferPtr, layout._vertices.data() + offset, count * sizeof(TextVertex));
+			_data.textVertexBufferPtr += count;
+			_data.textIndexCount += (uint32_t)(count / 4 * 6);
+			offset += count;
+		}
+
+		// Parts of the cached vertices now point to slots of different batches
+		if (split)
+			layout._verticesTexIndices.fill(-1.0f);
+
+		_data.stats.quadCount += (uint32_t)glyphs.size();
+	}
+
+	void Renderer2D::bindFontAtlasPages(TextLayout& layout, size_t firstGlyph)
+	{
+		// All pages of the layout have to fit in the same batch
+		const auto& pages = layout.getPages();
+		if (_data.fontAtlasSlotIndex + pages.size() > Renderer2DData::maxTextureSlots)
+			nextBatch();
+
+		bool changed = false;
+		for (uint32_t page : pages)
+		{
+			float texIndex = getFontAtlasIndex(layout.getFont()->getAtlasTexture(page));
+			changed |= layout._verticesTexIndices[page] != texIndex;
+			layout._verticesTexIndices[page] = texIndex;
+		}
+
+		if (!changed)
+			return;
+
+		// The atlas pages landed in other slots of this batch
+		const auto& glyphs = layout.getGlyphs();
+		for (size_t i = firstGlyph; i < layout._verticesGlyphCount; i++)
+		{
+			float texIndex = layout._verticesTexIndices[glyphs[i].page];
+
+			TextVertex* vertex = layout._vertices.data() + i * 4;
+			for (int j = 0; j < 4; j++)
+				vertex[j].texIndex = texIndex;
+		}
+	}
+
+	float Renderer2D::getFontAtlasIndex(const Ref<Texture2D>& atlas)
+	{
+		for (uint32_t i = 0; i < _data.fontAtlasSlotIndex; i++)
+		{
+			if (*_data.fontAtlasSlots[i] == *atlas)
+				return (float)i;
 		}
+
+		if (_data.fontAtlasSlotIndex >= Renderer2DData::maxTextureSlots)
+			nextBatch();
+
+		float index = (float)_data.fontAtlasSlotIndex;
+		_data.fontAtlasSlots[_data.fontAtlasSlotIndex] = atlas;
+		_data.fontAtlasSlotIndex++;
+
+		return index;
 	}
 
-	void Renderer2D::drawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int entityID)
+	const glm::mat4& Renderer2D::getViewProjection()
 	{
-		drawString(string, component.fontAsset, transform, { component.color, component.kerning, component.lineSpacing }, entityID);
+		return _data.cameraBuffer.viewProjection;
 	}
 
 	float Renderer2D::getLineWidth()
@@ -619,6 +819,7 @@ namespace Azteck
 		_data.textVertexBufferPtr = _data.textVertexBufferBase;
 
 		_data.textureSlotIndex = 1;
+		_data.fontAtlasSlotIndex = 0;
 	}
 
 	void Renderer2D::nextBatch()
@@ -747,6 +948,7 @@ namespace Azteck
 			{ ShaderDataType::Float3, "a_Position"     },
 			{ ShaderDataType::Float4, "a_Color"        },
 			{ ShaderDataType::Float2, "a_TexCoord"     },
+			{ ShaderDataType::Float,  "a_TexIndex"     },
 			{ ShaderDataType::Int,    "a_EntityID"     }
 			});
 
@@ -6,9 +6,13 @@
 #include "EditorCamera.h"
 #include "Azteck/Scene/Components.h"
 #include "Font.h"
+#include "TextLayout.h"
 
 namespace Azteck
 {
+	// Quads baked into a GPU resident vertex buffer, drawn without touching the per-frame batch
+	class StaticBatch2D;
+
 	class Renderer2D
 	{
 	public:
@@ -19,6 +23,18 @@ namespace Azteck
 			float lineSpacing = 0.0f;
 		};
 
+		struct StaticQuad
+		{
+			glm::mat4 transform;
+			glm::vec4 color;
+			Ref<Texture2D> texture;
+			float tilingFactor;
+			int entityID;
+
+			glm::vec2 texCoordMin{ 0.0f };
+			glm::vec2 texCoordMax{ 1.0f };
+		};
+
 	public:
 		static void init();
 		static void shutdown();
@@ -54,8 +70,22 @@ namespace Azteck
 
 		static void drawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID = -1);
 
+		// Appends alive particles to outVertices as untextured, axis aligned quads.
+		// Only reads the pool, so it is safe to call from worker threads
+		static void buildParticleVertices(const ParticlePool& pool, const ParticleProps& props, float z, int entityID, std::vector<QuadVertex>& outVertices);
+		// Copies prebuilt quads into the batch, they may only sample the white texture
+		static void drawQuadVertices(const QuadVertex* vertices, uint32_t quadCount);
+
+		// Static geometry. Quads are split into batches of at most maxTextureSlots textures
+		static void createStaticBatches(const std::vector<StaticQuad>& quads, std::vector<Ref<StaticBatch2D>>& outBatches);
+		static void drawStaticBatch(const Ref<StaticBatch2D>& batch);
+
 		static void drawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int entityID = -1);
-		static void drawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int entityID = -1);
+		static void drawString(const glm::mat4& transform, TextComponent& component, int entityID = -1);
+		static void drawString(TextLayout& layout, const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
+
+		// View projection of the current scene
+		static const glm::mat4& getViewProjection();
 
 		static float getLineWidth();
 		static void setLineWidth(float width);
@@ -84,6 +114,9 @@ namespace Azteck
 		static void drawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<Texture2D>& texture, const glm::vec4& color, float tilingFactor);
 		static void drawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, const glm::vec4& color, float tilingFactor);
 
+		static float getFontAtlasIndex(const Ref<Texture2D>& atlas);
+		static void bindFontAtlasPages(TextLayout& layout, size_t firstGlyph);
+
 		static void startBatch();
 		static void nextBatch();
 	};
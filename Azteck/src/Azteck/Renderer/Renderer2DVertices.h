@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace Azteck
+{
+	struct QuadVertex
+	{
+		glm::vec3 position;
+		glm::vec4 color;
+		glm::vec2 texCoord;
+		float texIndex;
+		float tilingFactor;
+
+		// Editor only
+		int entityID = -1;
+	};
+
+	struct CircleVertex
+	{
+		glm::vec3 worldPosition;
+		glm::vec3 localPosition;
+		glm::vec4 color;
+		float thickness;
+		float fade;
+
+		// Editor only
+		int entityID = -1;
+	};
+
+	struct LineVertex
+	{
+		glm::vec3 position;
+		glm::vec4 color;
+
+		// Editor only
+		int entityID = -1;
+	};
+
+	struct TextVertex
+	{
+		glm::vec3 position;
+		glm::vec4 color;
+		glm::vec2 texCoord;
+		float texIndex;
+
+		// TODO: bg color for outline/bg
+
+		// Editor-only
+		int entityID = -1;
+	};
+}
@@ -2,11 +2,17 @@
 #include "RendererAPI.h"
 
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Headless/HeadlessRendererAPI.h"
 
 namespace Azteck
 {
 	RendererAPI::API RendererAPI::_api = RendererAPI::API::OpenGL;
 
+	void RendererAPI::setAPI(API api)
+	{
+		_api = api;
+	}
+
 	Scope<RendererAPI> RendererAPI::create()
 	{
 		switch (_api)
@@ -22,6 +28,11 @@ namespace Azteck
 				return createScope<OpenGLRendererAPI>();
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return createScope<HeadlessRendererAPI>();
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -12,7 +12,9 @@ namespace Azteck
 		enum class API
 		{
 			None = 0,
-			OpenGL
+			OpenGL,
+			// No GPU work at all, for servers and tests
+			Headless
 		};
 
 	public:
@@ -29,6 +31,8 @@ namespace Azteck
 		virtual void setLineWidth(float width) = 0;
 
 		inline static API getAPI() { return _api; }
+		// Has to be picked before the renderer and any of its resources are created
+		static void setAPI(API api);
 
 		static Scope<RendererAPI> create();
 	private:
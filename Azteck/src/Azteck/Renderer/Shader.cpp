@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Headless/HeadlessShader.h"
 
 namespace Azteck
 {
@@ -21,6 +22,11 @@ namespace Azteck
 				return std::make_shared<OpenGLShader>(name, vertexSrc, fragmentSrc);
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return std::make_shared<HeadlessShader>(name, vertexSrc, fragmentSrc);
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -44,6 +50,11 @@ namespace Azteck
 				return std::make_shared<OpenGLShader>(filepath);
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return std::make_shared<HeadlessShader>(filepath);
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -0,0 +1,172 @@
+#include "azpch.h"
+#include "TextLayout.h"
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		static constexpr uint32_t replacementCharacter = 0xFFFD;
+
+		// Decodes the code point starting at index and moves index past it.
+		// Malformed sequences produce a single replacement character
+		static uint32_t decodeUTF8(const std::string& text, size_t& index)
+		{
+			uint8_t lead = (uint8_t)text[index++];
+			if (lead < 0x80)
+				return lead;
+
+			uint32_t codepoint;
+			uint32_t continuationCount;
+			if ((lead & 0xE0) == 0xC0)
+			{
+				codepoint = lead & 0x1F;
+				continuationCount = 1;
+			}
+			else if ((lead & 0xF0) == 0xE0)
+			{
+				codepoint = lead & 0x0F;
+				continuationCount = 2;
+			}
+			else if ((lead & 0xF8) == 0xF0)
+			{
+				codepoint = lead & 0x07;
+				continuationCount = 3;
+			}
+			else
+			{
+				return replacementCharacter;
+			}
+
+			for (uint32_t i = 0; i < continuationCount; i++)
+			{
+				if (index >= text.size() || ((uint8_t)text[index] & 0xC0) != 0x80)
+					return replacementCharacter;
+
+				codepoint = (codepoint << 6) | ((uint8_t)text[index++] & 0x3F);
+			}
+
+			// Overlong encodings, surrogates and values past the Unicode range
+			static constexpr uint32_t minCodepoint[] = { 0, 0x80, 0x800, 0x10000 };
+			if (codepoint < minCodepoint[continuationCount] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+				return replacementCharacter;
+
+			return codepoint;
+		}
+
+		static void decodeUTF8(const std::string& text, std::vector<uint32_t>& outCodepoints)
+		{
+			outCodepoints.clear();
+			outCodepoints.reserve(text.size());
+
+			size_t index = 0;
+			while (index < text.size())
+				outCodepoints.push_back(decodeUTF8(text, index));
+		}
+	}
+
+	void TextLayout::build(const std::string& text, const Ref<Font>& font, float kerning, float lineSpacing)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		_glyphs.clear();
+		_pages.clear();
+		_font = font;
+		_kerning = kerning;
+		_lineSpacing = lineSpacing;
+		_dirty = false;
+		_verticesGlyphCount = 0;
+		_glyphGeneration = font->getGlyphGeneration();
+		_hasMissingGlyphs = false;
+
+		_pen = { 0.0f, 0.0f };
+		_previousCodepoint = 0;
+
+		layoutText(text);
+	}
+
+	void TextLayout::append(const std::string& text)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		AZ_CORE_ASSERT(_font, "Layout has to be built before appending");
+		layoutText(text);
+	}
+
+	void TextLayout::layoutText(const std::string& text)
+	{
+		const FontMetrics& metrics = _font->getMetrics();
+
+		const FontGlyph* spaceGlyph = _font->getGlyph(' ');
+		const float spaceGlyphAdvance = spaceGlyph ? spaceGlyph->advance : 0.0f;
+
+		const float fsScale = 1.0f / (metrics.ascenderY - metrics.descenderY);
+
+		Utils::decodeUTF8(text, _codepoints);
+
+		for (uint32_t character : _codepoints)
+		{
+			// Kerning between a pair is applied once the second character is known,
+			// so appended text continues exactly where the previous run stopped
+			if (_previousCodepoint)
+				_pen.x += fsScale * _font->getKerning(_previousCodepoint, character);
+
+			_previousCodepoint = character;
+
+			if (character == '\r')
+			{
+				_previousCodepoint = 0;
+				continue;
+			}
+
+			if (character == '\n')
+			{
+				_pen.x = 0;
+				_pen.y -= fsScale * metrics.lineHeight + _lineSpacing;
+				_previousCodepoint = 0;
+				continue;
+			}
+
+			if (character == ' ')
+			{
+				_pen.x += fsScale * spaceGlyphAdvance + _kerning;
+				continue;
+			}
+
+			if (character == '\t')
+			{
+				_pen.x += 4.0f * (fsScale * spaceGlyphAdvance + _kerning);
+				_previousCodepoint = 0;
+				continue;
+			}
+
+			const FontGlyph* glyph = _font->getGlyph(character);
+
+			if (!glyph)
+			{
+				_hasMissingGlyphs = true;
+				glyph = _font->getGlyph('?');
+			}
+
+			if (!glyph)
+				return;
+
+			glm::vec2 quadMin = glyph->quadMin * fsScale + _pen;
+			glm::vec2 quadMax = glyph->quadMax * fsScale + _pen;
+
+			_glyphs.push_back({ quadMin, quadMax, glyph->texCoordMin, glyph->texCoordMax, glyph->page });
+
+			if (std::find(_pages.begin(), _pages.end(), glyph->page) == _pages.end())
+				_pages.push_back(glyph->page);
+
+			_pen.x += fsScale * glyph->advance + _kerning;
+		}
+	}
+
+	bool TextLayout::isValid(const Ref<Font>& font, float kerning, float lineSpacing) const
+	{
+		if (_dirty || _font != font || _kerning != kerning || _lineSpacing != lineSpacing)
+			return false;
+
+		return !_hasMissingGlyphs || _glyphGeneration == font->getGlyphGeneration();
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Azteck/Core/Core.h"
+#include "Font.h"
+#include "Renderer2DVertices.h"
+
+namespace Azteck
+{
+	// Glyph quads of a string in text space. Built once and reused
+	// until the text, font, kerning or line spacing change
+	class TextLayout
+	{
+	public:
+		struct Glyph
+		{
+			glm::vec2 quadMin;
+			glm::vec2 quadMax;
+			glm::vec2 texCoordMin;
+			glm::vec2 texCoordMax;
+			uint32_t page;
+		};
+
+	public:
+		void build(const std::string& text, const Ref<Font>& font, float kerning, float lineSpacing);
+
+		// Lays out text after what is already there. Only the new glyphs are transformed
+		// on the next draw, which keeps growing text like logs cheap
+		void append(const std::string& text);
+
+		// Has to be called when the text changes, other parameters are checked by isValid()
+		void invalidate() { _dirty = true; }
+		bool isValid(const Ref<Font>& font, float kerning, float lineSpacing) const;
+
+		const std::vector<Glyph>& getGlyphs() const { return _glyphs; }
+		const Ref<Font>& getFont() const { return _font; }
+
+		// Font atlas pages referenced by the glyphs
+		const std::vector<uint32_t>& getPages() const { return _pages; }
+
+	private:
+		void layoutText(const std::string& text);
+
+	private:
+		std::vector<Glyph> _glyphs;
+		std::vector<uint32_t> _pages;
+
+		Ref<Font> _font;
+		float _kerning = 0.0f;
+		float _lineSpacing = 0.0f;
+		bool _dirty = true;
+
+		glm::vec2 _pen{ 0.0f };
+		uint32_t _previousCodepoint = 0;
+		// Decoding scratch, kept so relayouts don't allocate
+		std::vector<uint32_t> _codepoints;
+
+		// Glyphs that were still being generated are filled in once the font has them
+		uint32_t _glyphGeneration = 0;
+		bool _hasMissingGlyphs = false;
+
+		// World space vertices of the last draw, reused while the transform and color stay the same.
+		// Only the first _verticesGlyphCount glyphs have up to date vertices
+		std::vector<TextVertex> _vertices;
+		glm::mat4 _verticesTransform{ 0.0f };
+		glm::vec4 _verticesColor{ 0.0f };
+		int _verticesEntityID = -1;
+		std::array<float, Font::maxAtlasPages> _verticesTexIndices{};
+		size_t _verticesGlyphCount = 0;
+
+		friend class Renderer2D;
+	};
+}
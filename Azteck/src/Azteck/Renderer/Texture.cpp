@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Headless/HeadlessTexture.h"
 
 namespace Azteck
 {
@@ -22,6 +23,11 @@ namespace Azteck
 				return createRef<OpenGLTexture2D>(path);
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return createRef<HeadlessTexture2D>(path);
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
@@ -45,6 +51,11 @@ namespace Azteck
 			return createRef<OpenGLTexture2D>(specification);
 		}
 
+		case RendererAPI::API::Headless:
+		{
+			return createRef<HeadlessTexture2D>(specification);
+		}
+
 		default:
 		{
 			AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
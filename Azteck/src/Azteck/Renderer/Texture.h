@@ -36,6 +36,7 @@ namespace Azteck
 		virtual bool isLoaded() const = 0;
 
 		virtual void setData(void* data, uint32_t size) = 0;
+		virtual void setSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
 		virtual void bind(uint32_t slot = 0) const = 0;
 
@@ -3,6 +3,7 @@
 
 #include "Azteck/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
+#include "Platform/Headless/HeadlessUniformBuffer.h"
 
 namespace Azteck 
 {
@@ -12,6 +13,7 @@ namespace Azteck
 		{
 		case RendererAPI::API::None:    AZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
 		case RendererAPI::API::OpenGL:  return createRef<OpenGLUniformBuffer>(size, binding);
+		case RendererAPI::API::Headless: return createRef<HeadlessUniformBuffer>(size, binding);
 		}
 
 		AZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Headless/HeadlessVertexArray.h"
 
 namespace Azteck
 {
@@ -21,6 +22,11 @@ namespace Azteck
 				return std::make_shared<OpenGLVertexArray>();
 			}
 
+			case RendererAPI::API::Headless:
+			{
+				return std::make_shared<HeadlessVertexArray>();
+			}
+
 			default:
 			{
 				AZ_CORE_ASSERT(false, "RendererAPI type is unknown");
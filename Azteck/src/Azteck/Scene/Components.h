@@ -1,5 +1,6 @@
 #pragma once
 
+#include <entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -9,10 +10,14 @@
 #include "Azteck/Scene/SceneCamera.h"
 #include "Azteck/Renderer/Texture.h"
 #include "Azteck/Renderer/Font.h"
+#include "Azteck/Renderer/TextLayout.h"
+#include "Azteck/Particles/ParticlePool.h"
 #include "Azteck/Core/UUID.h"
 
 namespace Azteck
 {
+	class StaticBatch2D;
+
 	struct IDComponent
 	{
 		IDComponent() = default;
@@ -56,6 +61,26 @@ namespace Azteck
 		glm::vec3 scale{ 1.0f };
 	};
 
+	// Parent/child links, TransformComponent holds the transform relative to the parent.
+	// Change links through Scene::setParent, the rest is derived by the scene
+	struct RelationshipComponent
+	{
+		RelationshipComponent() = default;
+		RelationshipComponent(const RelationshipComponent&) = default;
+
+		UUID parent = 0;
+		std::vector<UUID> children;
+
+		// Runtime, maintained by Scene::updateWorldTransforms
+		entt::entity runtimeParent = entt::null;
+		uint32_t runtimeDepth = 0;
+		// Position in breadth-first order, the storage is sorted by it
+		uint32_t runtimeOrder = 0;
+		glm::mat4 runtimeWorldTransform{ 1.0f };
+		// Set while the entity waits in the scene's dirty list
+		bool runtimeDirty = true;
+	};
+
 	struct SpriteRendererComponent
 	{
 		SpriteRendererComponent() = default;
@@ -68,6 +93,9 @@ namespace Azteck
 		glm::vec4 color{1.0f};
 		Ref<Texture2D> texture;
 		float tilingFactor = 1.0f;
+
+		// Static sprites are baked into retained batches instead of being batched every frame
+		bool isStatic = false;
 	};
 
 	struct CircleRendererComponent
@@ -133,6 +161,8 @@ namespace Azteck
 
 		// Storage for runtime
 		void* runtimeBody = nullptr;
+		glm::vec2 runtimePreviousPosition{ 0.0f };
+		float runtimePreviousAngle = 0.0f;
 	};
 
 	struct BoxCollider2DComponent
@@ -148,6 +178,9 @@ namespace Azteck
 		glm::vec2 offset{ 0.0f };
 		glm::vec2 size{ 0.5f };
 
+		// Triggers report overlaps but don't collide
+		bool isTrigger = false;
+
 		// Storage for runtime
 		void* runtimeFixture = nullptr;
 	};
@@ -165,6 +198,9 @@ namespace Azteck
 		float restitution = 0.0f;
 		float restitutionThreshold = 0.5f;
 
+		// Triggers report overlaps but don't collide
+		bool isTrigger = false;
+
 		// Storage for runtime
 		void* runtimeFixture = nullptr;
 	};
@@ -176,6 +212,104 @@ namespace Azteck
 		glm::vec4 color{ 1.0f };
 		float kerning = 0.0f;
 		float lineSpacing = 0.0f;
+
+		// Cached glyph quads, invalidate after changing textString
+		TextLayout layout;
+	};
+
+	struct TilemapComponent
+	{
+		static constexpr uint32_t chunkSize = 32;
+
+		struct Chunk
+		{
+			Ref<StaticBatch2D> batch;
+			bool dirty = true;
+		};
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+		glm::vec2 tileSize{ 1.0f };
+		glm::vec4 color{ 1.0f };
+
+		Ref<Texture2D> tileset;
+		uint32_t tilesetColumns = 1;
+		uint32_t tilesetRows = 1;
+
+		// Row major, starting at the bottom left. 0 is an empty cell, other values are tileset indices plus one
+		std::vector<uint16_t> tiles;
+
+		void resize(uint32_t newWidth, uint32_t newHeight)
+		{
+			std::vector<uint16_t> newTiles(newWidth * newHeight, 0);
+			for (uint32_t y = 0; y < std::min(height, newHeight); y++)
+			{
+				for (uint32_t x = 0; x < std::min(width, newWidth); x++)
+					newTiles[y * newWidth + x] = tiles[y * width + x];
+			}
+
+			width = newWidth;
+			height = newHeight;
+			tiles = std::move(newTiles);
+			invalidate();
+		}
+
+		uint16_t getTile(uint32_t x, uint32_t y) const
+		{
+			return x < width && y < height ? tiles[y * width + x] : 0;
+		}
+
+		void setTile(uint32_t x, uint32_t y, uint16_t tile)
+		{
+			if (x >= width || y >= height || tiles[y * width + x] == tile)
+				return;
+
+			tiles[y * width + x] = tile;
+
+			uint32_t chunkIndex = (y / chunkSize) * getChunkColumns() + x / chunkSize;
+			if (chunkIndex < runtimeChunks.size())
+				runtimeChunks[chunkIndex].dirty = true;
+		}
+
+		uint32_t getChunkColumns() const { return (width + chunkSize - 1) / chunkSize; }
+		uint32_t getChunkRows() const { return (height + chunkSize - 1) / chunkSize; }
+
+		// Rebuilds all chunks, needed after changing anything but single tiles
+		void invalidate()
+		{
+			runtimeChunks.clear();
+			runtimeChunks.resize(getChunkColumns() * getChunkRows());
+		}
+
+		// Storage for runtime
+		std::vector<Chunk> runtimeChunks;
+		glm::mat4 runtimeTransform{ 0.0f };
+	};
+
+	struct ParticleEmitterComponent
+	{
+		ParticleEmitterComponent() = default;
+
+		// Copies only the settings, every emitter simulates its own particles
+		ParticleEmitterComponent(const ParticleEmitterComponent& other)
+			: props(other.props), emitting(other.emitting)
+		{}
+
+		ParticleEmitterComponent& operator=(const ParticleEmitterComponent& other)
+		{
+			props = other.props;
+			emitting = other.emitting;
+			runtimePool = nullptr;
+			runtimeEmissionAccumulator = 0.0f;
+			return *this;
+		}
+
+		ParticleProps props;
+		bool emitting = true;
+
+		// Storage for runtime
+		Ref<ParticlePool> runtimePool;
+		float runtimeEmissionAccumulator = 0.0f;
 	};
 
 	template<typename... Component>
@@ -187,5 +321,5 @@ namespace Azteck
 		ComponentGroup<TransformComponent, SpriteRendererComponent,
 		CircleRendererComponent, CameraComponent, ScriptComponent,
 		NativeScriptComponent, Rigidbody2DComponent, BoxCollider2DComponent,
-		CircleCollider2DComponent, TextComponent>;
+		CircleCollider2DComponent, TextComponent, TilemapComponent, ParticleEmitterComponent>;
 }
@@ -1,6 +1,8 @@
 #include "azpch.h"
 #include "Scene.h"
 
+#include "Azteck/Core/JobSystem.h"
+#include "Azteck/Math/Math.h"
 #include "Azteck/Renderer/Renderer2D.h"
 #include "Components.h"
 #include "Entity.h"
@@ -8,15 +10,103 @@
 
 #include "Azteck/Scripting/ScriptEngine.h"
 #include "Azteck/Physics/Physics2D.h"
+#include "Azteck/Physics/Physics2DContactListener.h"
 
 #include "box2d/b2_world.h"
 #include "box2d/b2_body.h"
 #include "box2d/b2_fixture.h"
 #include "box2d/b2_polygon_shape.h"
 #include "box2d/b2_circle_shape.h"
+#include "box2d/b2_collision.h"
+#include "box2d/b2_distance.h"
+#include "box2d/b2_world_callbacks.h"
 
 namespace Azteck
 {
+	static entt::entity getFixtureEntity(const b2Fixture* fixture)
+	{
+		return static_cast<entt::entity>(fixture->GetUserData().pointer);
+	}
+
+	class ClosestRaycastCallback : public b2RayCastCallback
+	{
+	public:
+		float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+		{
+			this->fixture = fixture;
+			this->point = point;
+			this->normal = normal;
+			this->fraction = fraction;
+
+			// Clip the ray so only closer fixtures are reported afterwards
+			return fraction;
+		}
+
+		b2Fixture* fixture = nullptr;
+		b2Vec2 point;
+		b2Vec2 normal;
+		float fraction = 1.0f;
+	};
+
+	class AllRaycastCallback : public b2RayCastCallback
+	{
+	public:
+		struct Hit
+		{
+			b2Fixture* fixture;
+			b2Vec2 point;
+			b2Vec2 normal;
+			float fraction;
+		};
+
+		float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override
+		{
+			hits.push_back({ fixture, point, normal, fraction });
+			return 1.0f;
+		}
+
+		std::vector<Hit> hits;
+	};
+
+	class OverlapQueryCallback : public b2QueryCallback
+	{
+	public:
+		OverlapQueryCallback(const b2Shape& shape, const b2Transform& transform, std::vector<b2Fixture*>& fixtures)
+			: _shape(shape), _transform(transform), _fixtures(fixtures)
+		{}
+
+		bool ReportFixture(b2Fixture* fixture) override
+		{
+			// The broadphase only compares bounding boxes, so test the actual shapes
+			if (b2TestOverlap(fixture->GetShape(), 0, &_shape, 0, fixture->GetBody()->GetTransform(), _transform))
+				_fixtures.push_back(fixture);
+
+			return true;
+		}
+
+	private:
+		const b2Shape& _shape;
+		const b2Transform& _transform;
+		std::vector<b2Fixture*>& _fixtures;
+	};
+
+	class CandidateQueryCallback : public b2QueryCallback
+	{
+	public:
+		CandidateQueryCallback(std::vector<b2Fixture*>& fixtures)
+			: _fixtures(fixtures)
+		{}
+
+		bool ReportFixture(b2Fixture* fixture) override
+		{
+			_fixtures.push_back(fixture);
+			return true;
+		}
+
+	private:
+		std::vector<b2Fixture*>& _fixtures;
+	};
+
 	Scene::Scene()
 		: _viewportWidth(0)
 		, _viewportHeight(0)
@@ -24,11 +114,35 @@ namespace Azteck
 		, _isPaused(false)
 		, _stepFrames(0)
 	{
+		// Owning both storages lets the world transform pass walk them linearly once sorted
+		_registry.group<RelationshipComponent, TransformComponent>();
+		_registry.on_construct<RelationshipComponent>().connect<&Scene::onRelationshipConstruct>(*this);
+		_registry.on_destroy<RelationshipComponent>().connect<&Scene::onRelationshipDestroy>(*this);
+
+		_registry.on_construct<SpriteRendererComponent>().connect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_update<SpriteRendererComponent>().connect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_destroy<SpriteRendererComponent>().connect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_update<TransformComponent>().connect<&Scene::onTransformUpdate>(*this);
+		_registry.on_construct<TagComponent>().connect<&Scene::onTagConstruct>(*this);
+		_registry.on_update<TagComponent>().connect<&Scene::onTagUpdate>(*this);
+		_registry.on_destroy<TagComponent>().connect<&Scene::onTagDestroy>(*this);
 	}
 
 	Scene::~Scene()
 	{
-		delete _physicsWorld;
+		if (_physicsWorld)
+			onPhysics2DStop();
+
+		_registry.on_construct<RelationshipComponent>().disconnect<&Scene::onRelationshipConstruct>(*this);
+		_registry.on_destroy<RelationshipComponent>().disconnect<&Scene::onRelationshipDestroy>(*this);
+
+		_registry.on_construct<SpriteRendererComponent>().disconnect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_update<SpriteRendererComponent>().disconnect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_destroy<SpriteRendererComponent>().disconnect<&Scene::onSpriteRendererChanged>(*this);
+		_registry.on_update<TransformComponent>().disconnect<&Scene::onTransformUpdate>(*this);
+		_registry.on_construct<TagComponent>().disconnect<&Scene::onTagConstruct>(*this);
+		_registry.on_update<TagComponent>().disconnect<&Scene::onTagUpdate>(*this);
+		_registry.on_destroy<TagComponent>().disconnect<&Scene::onTagDestroy>(*this);
 	}
 
 	Entity Scene::createEntity(const std::string& name)
@@ -41,9 +155,10 @@ namespace Azteck
 		Entity entity{ _registry.create(), this };
 		entity.addComponent<IDComponent>(uuid);
 		entity.addComponent<TransformComponent>();
+		entity.addComponent<RelationshipComponent>();
 
-		auto& tag = entity.addComponent<TagComponent>();
-		tag.tag = name.empty() ? "Entity" : name;
+		// Named on construction so the name index sees the final tag
+		entity.addComponent<TagComponent>(name.empty() ? "Entity" : name);
 
 		_entityMap[uuid] = entity;
 
@@ -52,6 +167,21 @@ namespace Azteck
 
 	void Scene::destroyEntity(Entity entity)
 	{
+		// Copied, every child removes itself from the list while being destroyed
+		std::vector<UUID> children = entity.getComponent<RelationshipComponent>().children;
+		for (UUID child : children)
+		{
+			if (Entity childEntity = getEntityByUUID(child))
+				destroyEntity(childEntity);
+		}
+
+		// Leaving the parent's child list is enough, removing a leaf doesn't need a hierarchy rebuild
+		if (Entity parent = getParent(entity))
+		{
+			auto& siblings = parent.getComponent<RelationshipComponent>().children;
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), entity.getUUID()), siblings.end());
+		}
+
 		_entityMap.erase(entity.getUUID());
 		_registry.destroy(entity);
 	}
@@ -97,11 +227,26 @@ namespace Azteck
 
 	void Scene::onUpdateRuntime(Timestep ts)
 	{
-		if (!_isPaused || _stepFrames-- > 0)
+		const bool advance = !_isPaused || _stepFrames-- > 0;
+		if (advance)
 		{
 			onUpdateScriptComponents(ts);
 			onUpdateNativeScriptComponents(ts);
-			onUpdatePhysics(ts);
+
+			// Stepping a paused scene advances physics by exactly one fixed step
+			onUpdatePhysics(_isPaused ? Timestep(_physics2DSettings.fixedTimestep) : ts);
+		}
+
+		// Everything after this reads world transforms
+		updateWorldTransforms();
+
+		if (advance)
+		{
+			onUpdateParticles(ts);
+
+			// All contacts of the frame go to the scripts at once
+			ScriptEngine::onContactEvents(_contactListener->getEvents());
+			_contactListener->clear();
 		}
 
 		Entity primaryCameraEntity = getPrimaryCamera();
@@ -109,34 +254,28 @@ namespace Azteck
 		if (primaryCameraEntity)
 		{
 			auto& cameraComponent = primaryCameraEntity.getComponent<CameraComponent>();
-			auto& transformComponent = primaryCameraEntity.getComponent<TransformComponent>();
 
-			Renderer2D::beginScene(cameraComponent.camera, transformComponent.getTransform());
+			Renderer2D::beginScene(cameraComponent.camera, getWorldTransform(primaryCameraEntity));
 
-			{
-				auto view = getAllEntitiesWith<TransformComponent, SpriteRendererComponent>();
-				for (auto entity : view)
-				{
-					auto [transform, sprite] = view.get<TransformComponent, SpriteRendererComponent>(entity);
-					Renderer2D::drawSprite(transform.getTransform(), sprite, static_cast<int>(entity));
-				}
-			}
+			renderTilemaps();
+			renderSprites();
+			renderParticles();
 
 			{
 				auto view = getAllEntitiesWith<TransformComponent, CircleRendererComponent>();
 				for (auto entity : view)
 				{
-					auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-					Renderer2D::drawCircle(transform.getTransform(), circle.color, circle.thickness, circle.fade, static_cast<int>(entity));
+					auto& circle = view.get<CircleRendererComponent>(entity);
+					Renderer2D::drawCircle(getWorldTransform(entity), circle.color, circle.thickness, circle.fade, static_cast<int>(entity));
 				}
 			}
 			{
 				auto view = getAllEntitiesWith<TransformComponent, TextComponent>();
 				for (auto entity : view)
 				{
-					auto [transform, text] = view.get<TransformComponent, TextComponent>(entity);
+					auto& text = view.get<TextComponent>(entity);
 
-					Renderer2D::drawString(text.textString, transform.getTransform(), text, static_cast<int>(entity));
+					Renderer2D::drawString(getWorldTransform(entity), text, static_cast<int>(entity));
 				}
 			}
 
@@ -146,14 +285,32 @@ namespace Azteck
 
 	void Scene::onUpdateSimulation(Timestep ts, EditorCamera& camera)
 	{
-		if (!_isPaused || _stepFrames-- > 0)
-			onUpdatePhysics(ts);
+		const bool advance = !_isPaused || _stepFrames-- > 0;
+		if (advance)
+			onUpdatePhysics(_isPaused ? Timestep(_physics2DSettings.fixedTimestep) : ts);
+
+		updateWorldTransforms();
+
+		if (advance)
+		{
+			onUpdateParticles(ts);
+			_contactListener->clear();
+		}
 
 		renderScene(camera);
 	}
 
+	void Scene::stepPhysics(Timestep ts)
+	{
+		onUpdatePhysics(ts);
+		updateWorldTransforms();
+
+		_contactListener->clear();
+	}
+
 	void Scene::onUpdateEditor(Timestep ts, EditorCamera& camera)
 	{
+		updateWorldTransforms();
 		renderScene(camera);
 	}
 
@@ -234,9 +391,188 @@ namespace Azteck
 
 		copyComponentIfExists(AllComponents{}, newEntity, entity);
 
+		// The copy sits next to the original, with copies of its children
+		setParent(newEntity, getParent(entity));
+
+		std::vector<UUID> children = entity.getComponent<RelationshipComponent>().children;
+		for (UUID child : children)
+		{
+			if (Entity childEntity = getEntityByUUID(child))
+				setParent(duplicateEntity(childEntity), newEntity);
+		}
+
 		return newEntity;
 	}
 
+	void Scene::setParent(Entity entity, Entity parent)
+	{
+		auto& relationship = entity.getComponent<RelationshipComponent>();
+		UUID parentID = parent ? parent.getUUID() : UUID(0);
+
+		if (relationship.parent == parentID)
+			return;
+
+		if (parent && (parent == entity || isAncestorOf(entity, parent)))
+		{
+			AZ_CORE_WARN("Cannot parent {0} to its own descendant {1}", entity.getName(), parent.getName());
+			return;
+		}
+
+		UUID entityID = entity.getUUID();
+		if (Entity oldParent = getEntityByUUID(relationship.parent))
+		{
+			auto& siblings = oldParent.getComponent<RelationshipComponent>().children;
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), entityID), siblings.end());
+		}
+
+		relationship.parent = parentID;
+		if (parent)
+			parent.getComponent<RelationshipComponent>().children.push_back(entityID);
+
+		_hierarchyDirty = true;
+		_hierarchyVersion++;
+	}
+
+	Entity Scene::getParent(Entity entity)
+	{
+		return getEntityByUUID(entity.getComponent<RelationshipComponent>().parent);
+	}
+
+	bool Scene::isAncestorOf(Entity ancestor, Entity entity)
+	{
+		for (Entity current = getParent(entity); current; current = getParent(current))
+		{
+			if (current == ancestor)
+				return true;
+		}
+
+		return false;
+	}
+
+	const glm::mat4& Scene::getWorldTransform(entt::entity entity) const
+	{
+		return _registry.get<RelationshipComponent>(entity).runtimeWorldTransform;
+	}
+
+	void Scene::rebuildHierarchy()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		// Breadth-first from the roots, so parents always come before their children
+		std::vector<entt::entity> queue;
+		queue.reserve(_registry.storage<RelationshipComponent>().size());
+
+		auto view = _registry.view<RelationshipComponent>();
+		for (auto entity : view)
+		{
+			auto& relationship = view.get<RelationshipComponent>(entity);
+			relationship.runtimeParent = entt::null;
+			relationship.runtimeDepth = 0;
+			relationship.runtimeDirty = true;
+
+			if (!getEntityByUUID(relationship.parent))
+				queue.push_back(entity);
+		}
+
+		for (size_t i = 0; i < queue.size(); i++)
+		{
+			auto& relationship = _registry.get<RelationshipComponent>(queue[i]);
+			relationship.runtimeOrder = (uint32_t)i;
+
+			for (UUID child : relationship.children)
+			{
+				Entity childEntity = getEntityByUUID(child);
+				if (!childEntity)
+					continue;
+
+				auto& childRelationship = childEntity.getComponent<RelationshipComponent>();
+				childRelationship.runtimeParent = queue[i];
+				childRelationship.runtimeDepth = relationship.runtimeDepth + 1;
+				queue.push_back(childEntity);
+			}
+		}
+
+		_registry.group<RelationshipComponent, TransformComponent>().sort([this](const entt::entity lhs, const entt::entity rhs)
+			{
+				return _registry.get<RelationshipComponent>(lhs).runtimeOrder < _registry.get<RelationshipComponent>(rhs).runtimeOrder;
+			});
+
+		_hierarchyDirty = false;
+	}
+
+	void Scene::updateWorldTransforms()
+	{
+		AZ_PROFILE_FUNCTION();
+
+		if (_hierarchyDirty)
+		{
+			rebuildHierarchy();
+
+			// Parents come before their children in the sorted storage
+			auto group = _registry.group<RelationshipComponent, TransformComponent>();
+			for (auto entity : group)
+			{
+				auto [relationship, transform] = group.get<RelationshipComponent, TransformComponent>(entity);
+				relationship.runtimeWorldTransform = relationship.runtimeParent != entt::null
+					? group.get<RelationshipComponent>(relationship.runtimeParent).runtimeWorldTransform * transform.getTransform()
+					: transform.getTransform();
+				relationship.runtimeDirty = false;
+			}
+
+			_dirtyTransforms.clear();
+			_staticBatchesDirty = true;
+			return;
+		}
+
+		if (_dirtyTransforms.empty())
+			return;
+
+		// Ancestors have a lower breadth-first order, so a dirty descendant is already done when it comes up
+		_dirtyTransforms.erase(std::remove_if(_dirtyTransforms.begin(), _dirtyTransforms.end(),
+			[this](entt::entity entity) { return !_registry.valid(entity); }), _dirtyTransforms.end());
+
+		std::sort(_dirtyTransforms.begin(), _dirtyTransforms.end(), [this](entt::entity lhs, entt::entity rhs)
+			{
+				return _registry.get<RelationshipComponent>(lhs).runtimeOrder < _registry.get<RelationshipComponent>(rhs).runtimeOrder;
+			});
+
+		for (entt::entity entity : _dirtyTransforms)
+		{
+			if (_registry.get<RelationshipComponent>(entity).runtimeDirty)
+				updateWorldTransformSubtree(entity);
+		}
+
+		_dirtyTransforms.clear();
+	}
+
+	void Scene::updateWorldTransformSubtree(entt::entity entity)
+	{
+		auto [relationship, transform] = _registry.get<RelationshipComponent, TransformComponent>(entity);
+		relationship.runtimeWorldTransform = relationship.runtimeParent != entt::null
+			? _registry.get<RelationshipComponent>(relationship.runtimeParent).runtimeWorldTransform * transform.getTransform()
+			: transform.getTransform();
+		relationship.runtimeDirty = false;
+
+		if (auto* sprite = _registry.try_get<SpriteRendererComponent>(entity); sprite && sprite->isStatic)
+			_staticBatchesDirty = true;
+
+		for (UUID child : relationship.children)
+		{
+			if (Entity childEntity = getEntityByUUID(child))
+				updateWorldTransformSubtree(childEntity);
+		}
+	}
+
+	void Scene::markTransformDirty(entt::entity entity)
+	{
+		auto& relationship = _registry.get<RelationshipComponent>(entity);
+		if (relationship.runtimeDirty)
+			return;
+
+		relationship.runtimeDirty = true;
+		_dirtyTransforms.push_back(entity);
+	}
+
 	Entity Scene::getEntityByUUID(UUID uuid)
 	{
 		if (_entityMap.find(uuid) != _entityMap.end())
@@ -247,24 +583,68 @@ namespace Azteck
 
 	Entity Scene::getEntityByName(std::string_view name)
 	{
-		auto view = getAllEntitiesWith<TagComponent>();
+		return getEntityByName(name, std::hash<std::string_view>{}(name));
+	}
 
-		for (auto entity : view)
+	Entity Scene::getEntityByName(std::string_view name, size_t nameHash)
+	{
+		auto [begin, end] = _nameIndex.equal_range(nameHash);
+		for (auto it = begin; it != end; ++it)
 		{
-			const TagComponent& tc = view.get<TagComponent>(entity);
-			if (tc.tag == name)
-				return Entity{ entity, this };
+			if (_registry.get<TagComponent>(it->second).tag == name)
+				return Entity{ it->second, this };
 		}
 
 		return {};
 	}
 
+	void Scene::setEntityName(Entity entity, const std::string& name)
+	{
+		_registry.patch<TagComponent>(entity, [&name](TagComponent& tag) { tag.tag = name; });
+	}
+
+	Entity Scene::pickEntity2D(const glm::vec2& point)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		entt::entity picked = entt::null;
+		float pickedZ = -std::numeric_limits<float>::max();
+
+		// Later entities are drawn on top, so they win ties
+		auto testQuad = [&](entt::entity entity, bool circle)
+		{
+			const glm::mat4& transform = getWorldTransform(entity);
+			const float z = transform[3].z;
+			if (z < pickedZ)
+				return;
+
+			glm::vec4 local = glm::inverse(transform) * glm::vec4(point, z, 1.0f);
+			bool inside = circle
+				? glm::dot(glm::vec2(local), glm::vec2(local)) <= 0.25f
+				: std::abs(local.x) <= 0.5f && std::abs(local.y) <= 0.5f;
+
+			if (inside)
+			{
+				picked = entity;
+				pickedZ = z;
+			}
+		};
+
+		for (auto entity : _registry.view<TransformComponent, SpriteRendererComponent>())
+			testQuad(entity, false);
+		for (auto entity : _registry.view<TransformComponent, CircleRendererComponent>())
+			testQuad(entity, true);
+
+		return picked == entt::null ? Entity() : Entity(picked, this);
+	}
+
 	Ref<Scene> Scene::copy(const Ref<Scene>& other)
 	{
 		Ref<Scene> newScene = createRef<Scene>();
 
 		newScene->_viewportWidth = other->_viewportWidth;
 		newScene->_viewportHeight = other->_viewportHeight;
+		newScene->_physics2DSettings = other->_physics2DSettings;
 
 		auto& srcSceneRegistry = other->_registry;
 		auto& dstSceneRegistry = newScene->_registry;
@@ -280,6 +660,8 @@ namespace Azteck
 		}
 
 		copyComponent(AllComponents{}, dstSceneRegistry, srcSceneRegistry, enttMap);
+		// Links are stored as UUIDs, so they carry over as they are
+		copyComponent<RelationshipComponent>(dstSceneRegistry, srcSceneRegistry, enttMap);
 
 		return newScene;
 	}
@@ -287,30 +669,99 @@ namespace Azteck
 	void Scene::onPhysics2DStart()
 	{
 		_physicsWorld = new b2World({ 0.0f, -9.8f });
+		_physicsAccumulator = 0.0f;
+
+		_contactListener = new Physics2DContactListener(_registry);
+		_physicsWorld->SetContactListener(_contactListener);
 
 		auto view = getAllEntitiesWith<Rigidbody2DComponent>();
 		for (auto e : view)
-		{
-			Entity entity = { e, this };
+			createPhysicsBody(e);
+
+		// Keep the world in sync with components added or removed while the scene is running
+		_registry.on_construct<Rigidbody2DComponent>().connect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_construct<BoxCollider2DComponent>().connect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_construct<CircleCollider2DComponent>().connect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_destroy<Rigidbody2DComponent>().connect<&Scene::onRigidbody2DDestroy>(*this);
+		_registry.on_destroy<BoxCollider2DComponent>().connect<&Scene::onBoxCollider2DDestroy>(*this);
+		_registry.on_destroy<CircleCollider2DComponent>().connect<&Scene::onCircleCollider2DDestroy>(*this);
+	}
+
+	void Scene::onPhysics2DStop()
+	{
+		_registry.on_construct<Rigidbody2DComponent>().disconnect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_construct<BoxCollider2DComponent>().disconnect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_construct<CircleCollider2DComponent>().disconnect<&Scene::onPhysicsComponentConstruct>(*this);
+		_registry.on_destroy<Rigidbody2DComponent>().disconnect<&Scene::onRigidbody2DDestroy>(*this);
+		_registry.on_destroy<BoxCollider2DComponent>().disconnect<&Scene::onBoxCollider2DDestroy>(*this);
+		_registry.on_destroy<CircleCollider2DComponent>().disconnect<&Scene::onCircleCollider2DDestroy>(*this);
+
+		_pendingPhysicsBodies.clear();
+		_awakeBodies.clear();
+
+		for (auto e : getAllEntitiesWith<Rigidbody2DComponent>())
+			_registry.get<Rigidbody2DComponent>(e).runtimeBody = nullptr;
 
-			auto& transform = entity.getComponent<TransformComponent>();
-			auto& rb2d = entity.getComponent<Rigidbody2DComponent>();
+		for (auto e : getAllEntitiesWith<BoxCollider2DComponent>())
+			_registry.get<BoxCollider2DComponent>(e).runtimeFixture = nullptr;
 
+		for (auto e : getAllEntitiesWith<CircleCollider2DComponent>())
+			_registry.get<CircleCollider2DComponent>(e).runtimeFixture = nullptr;
+
+		delete _physicsWorld;
+		_physicsWorld = nullptr;
+
+		delete _contactListener;
+		_contactListener = nullptr;
+	}
+
+	glm::mat4 Scene::computeWorldTransform(entt::entity entity)
+	{
+		glm::mat4 transform = _registry.get<TransformComponent>(entity).getTransform();
+		for (Entity parent = getParent({ entity, this }); parent; parent = getParent(parent))
+			transform = parent.getComponent<TransformComponent>().getTransform() * transform;
+
+		return transform;
+	}
+
+	void Scene::createPhysicsBody(entt::entity e)
+	{
+		if (!_registry.valid(e) || !_registry.all_of<Rigidbody2DComponent>(e))
+			return;
+
+		Entity entity = { e, this };
+
+		auto& rb2d = entity.getComponent<Rigidbody2DComponent>();
+
+		// Box2D lives in world space, children of other entities included
+		glm::vec3 translation{ 0.0f }, rotation{ 0.0f }, scale{ 1.0f };
+		Math::decomposeTransform(computeWorldTransform(e), translation, rotation, scale);
+
+		b2Body* body = (b2Body*)rb2d.runtimeBody;
+
+		if (!body)
+		{
 			b2BodyDef bodyDef;
 			bodyDef.type = Utils::rigidbody2DTypeToBox2DBody(rb2d.type);
 			bodyDef.fixedRotation = rb2d.fixedRotation;
-			bodyDef.position.Set(transform.translation.x, transform.translation.y);
-			bodyDef.angle = transform.rotation.z;
+			bodyDef.position.Set(translation.x, translation.y);
+			bodyDef.angle = rotation.z;
+			bodyDef.userData.pointer = static_cast<uintptr_t>(e);
 
-			b2Body* body = _physicsWorld->CreateBody(&bodyDef);
+			body = _physicsWorld->CreateBody(&bodyDef);
 			rb2d.runtimeBody = body;
+			rb2d.runtimePreviousPosition = { translation.x, translation.y };
+			rb2d.runtimePreviousAngle = rotation.z;
+		}
 
-			if (entity.hasComponent<BoxCollider2DComponent>())
-			{
-				auto& bc2d = entity.getComponent<BoxCollider2DComponent>();
+		if (entity.hasComponent<BoxCollider2DComponent>())
+		{
+			auto& bc2d = entity.getComponent<BoxCollider2DComponent>();
 
+			if (!bc2d.runtimeFixture)
+			{
 				b2PolygonShape shape;
-				shape.SetAsBox(bc2d.size.x * transform.scale.x, bc2d.size.y * transform.scale.y, b2Vec2(bc2d.offset.x, bc2d.offset.y), 0.0f);
+				shape.SetAsBox(bc2d.size.x * scale.x, bc2d.size.y * scale.y, b2Vec2(bc2d.offset.x, bc2d.offset.y), 0.0f);
 
 				b2FixtureDef fixtureDef;
 				fixtureDef.shape = &shape;
@@ -318,16 +769,21 @@ namespace Azteck
 				fixtureDef.friction = bc2d.friction;
 				fixtureDef.restitution = bc2d.restitution;
 				fixtureDef.restitutionThreshold = bc2d.restitutionThreshold;
-				body->CreateFixture(&fixtureDef);
+				fixtureDef.isSensor = bc2d.isTrigger;
+				fixtureDef.userData.pointer = static_cast<uintptr_t>(e);
+				bc2d.runtimeFixture = body->CreateFixture(&fixtureDef);
 			}
+		}
 
-			if (entity.hasComponent<CircleCollider2DComponent>())
-			{
-				auto& cc2d = entity.getComponent<CircleCollider2DComponent>();
+		if (entity.hasComponent<CircleCollider2DComponent>())
+		{
+			auto& cc2d = entity.getComponent<CircleCollider2DComponent>();
 
+			if (!cc2d.runtimeFixture)
+			{
 				b2CircleShape circleShape;
 				circleShape.m_p.Set(cc2d.offset.x, cc2d.offset.y);
-				circleShape.m_radius = transform.scale.x * cc2d.radius;
+				circleShape.m_radius = scale.x * cc2d.radius;
 
 				b2FixtureDef fixtureDef;
 				fixtureDef.shape = &circleShape;
@@ -335,44 +791,313 @@ namespace Azteck
 				fixtureDef.friction = cc2d.friction;
 				fixtureDef.restitution = cc2d.restitution;
 				fixtureDef.restitutionThreshold = cc2d.restitutionThreshold;
-				body->CreateFixture(&fixtureDef);
+				fixtureDef.isSensor = cc2d.isTrigger;
+				fixtureDef.userData.pointer = static_cast<uintptr_t>(e);
+				cc2d.runtimeFixture = body->CreateFixture(&fixtureDef);
 			}
 		}
 	}
 
-	void Scene::onPhysics2DStop()
+	void Scene::createPendingPhysicsBodies()
 	{
-		delete _physicsWorld;
-		_physicsWorld = nullptr;
+		for (auto e : _pendingPhysicsBodies)
+			createPhysicsBody(e);
+
+		_pendingPhysicsBodies.clear();
+	}
+
+	void Scene::onPhysicsComponentConstruct(entt::registry& registry, entt::entity entity)
+	{
+		// Components are usually filled in right after being added,
+		// so the body is created lazily before the next physics step
+		_pendingPhysicsBodies.push_back(entity);
+	}
+
+	void Scene::onRigidbody2DDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto& rb2d = registry.get<Rigidbody2DComponent>(entity);
+		if (!rb2d.runtimeBody)
+			return;
+
+		// Fixtures are owned by the body and go away with it
+		if (auto* bc2d = registry.try_get<BoxCollider2DComponent>(entity))
+			bc2d->runtimeFixture = nullptr;
+
+		if (auto* cc2d = registry.try_get<CircleCollider2DComponent>(entity))
+			cc2d->runtimeFixture = nullptr;
+
+		_physicsWorld->DestroyBody((b2Body*)rb2d.runtimeBody);
+		rb2d.runtimeBody = nullptr;
+	}
+
+	void Scene::onBoxCollider2DDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto& bc2d = registry.get<BoxCollider2DComponent>(entity);
+		if (!bc2d.runtimeFixture)
+			return;
+
+		b2Fixture* fixture = (b2Fixture*)bc2d.runtimeFixture;
+		fixture->GetBody()->DestroyFixture(fixture);
+		bc2d.runtimeFixture = nullptr;
+	}
+
+	void Scene::onCircleCollider2DDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto& cc2d = registry.get<CircleCollider2DComponent>(entity);
+		if (!cc2d.runtimeFixture)
+			return;
+
+		b2Fixture* fixture = (b2Fixture*)cc2d.runtimeFixture;
+		fixture->GetBody()->DestroyFixture(fixture);
+		cc2d.runtimeFixture = nullptr;
 	}
 
 	void Scene::onUpdatePhysics(Timestep ts)
 	{
-		if (_physicsWorld)
+		if (!_physicsWorld)
+			return;
+
+		createPendingPhysicsBodies();
+
+		const float fixedTimestep = _physics2DSettings.fixedTimestep;
+		AZ_CORE_ASSERT(fixedTimestep > 0.0f, "Physics timestep must be positive");
+
+		// Clamp the backlog so a long frame doesn't snowball into ever more steps
+		_physicsAccumulator = std::min(_physicsAccumulator + ts, fixedTimestep * _physics2DSettings.maxSubsteps);
+
+		int steps = static_cast<int>(_physicsAccumulator / fixedTimestep);
+		_physicsAccumulator -= steps * fixedTimestep;
+
+		for (; steps > 0; --steps)
 		{
-			const int32_t velocityIterations = 6;
-			const int32_t positionsIterations = 2;
+			// Only the state before the last step is needed for interpolation
+			if (steps == 1)
+			{
+				for (b2Body* body = _physicsWorld->GetBodyList(); body; body = body->GetNext())
+				{
+					if (body->GetType() == b2_staticBody || !body->IsAwake())
+						continue;
 
-			_physicsWorld->Step(ts, velocityIterations, positionsIterations);
+					auto& rb2d = _registry.get<Rigidbody2DComponent>((entt::entity)body->GetUserData().pointer);
+					const auto& position = body->GetPosition();
+					rb2d.runtimePreviousPosition = { position.x, position.y };
+					rb2d.runtimePreviousAngle = body->GetAngle();
+				}
+			}
+
+			_physicsWorld->Step(fixedTimestep, _physics2DSettings.velocityIterations, _physics2DSettings.positionIterations);
+		}
+
+		const float alpha = _physics2DSettings.interpolation ? _physicsAccumulator / fixedTimestep : 1.0f;
+
+		// Get transform from Box2D. Static and sleeping bodies don't move, so only the body list is walked,
+		// components are touched for moving bodies alone
+		auto syncTransform = [this, alpha](entt::entity entity, b2Body* body, bool awake)
+		{
+			auto [rb2d, transform] = _registry.get<Rigidbody2DComponent, TransformComponent>(entity);
+
+			const auto& position = body->GetPosition();
+			glm::vec2 currentPosition = { position.x, position.y };
+			float currentAngle = body->GetAngle();
 
-			// Get transform from Box2D
-			auto view = getAllEntitiesWith<Rigidbody2DComponent>();
-			for (auto e : view)
+			if (!awake)
 			{
-				Entity entity = { e, this };
+				rb2d.runtimePreviousPosition = currentPosition;
+				rb2d.runtimePreviousAngle = currentAngle;
+			}
+
+			glm::vec2 translation = glm::mix(rb2d.runtimePreviousPosition, currentPosition, alpha);
+			float angle = glm::mix(rb2d.runtimePreviousAngle, currentAngle, alpha);
+
+			// The body pose is in world space, children store it relative to their parent.
+			// Parents are assumed to be 2D, rotated around z only
+			if (Entity parent = getParent({ entity, this }))
+			{
+				glm::mat4 parentWorld = computeWorldTransform(parent);
+				translation = glm::vec2(glm::inverse(parentWorld) * glm::vec4(translation, 0.0f, 1.0f));
+				angle -= std::atan2(parentWorld[0][1], parentWorld[0][0]);
+			}
+
+			transform.translation.x = translation.x;
+			transform.translation.y = translation.y;
+			transform.rotation.z = angle;
+
+			markTransformDirty(entity);
+		};
+
+		// A body that fell asleep since the last sync still needs its resting transform once
+		for (entt::entity entity : _awakeBodies)
+		{
+			auto* rb2d = _registry.valid(entity) ? _registry.try_get<Rigidbody2DComponent>(entity) : nullptr;
+			b2Body* body = rb2d ? (b2Body*)rb2d->runtimeBody : nullptr;
+			if (body && body->GetType() != b2_staticBody && !body->IsAwake())
+				syncTransform(entity, body, false);
+		}
+
+		_awakeBodies.clear();
+		for (b2Body* body = _physicsWorld->GetBodyList(); body; body = body->GetNext())
+		{
+			if (body->GetType() == b2_staticBody || !body->IsAwake())
+				continue;
+
+			entt::entity entity = (entt::entity)body->GetUserData().pointer;
+			syncTransform(entity, body, true);
+			_awakeBodies.push_back(entity);
+		}
+	}
+
+	bool Scene::raycast2D(const glm::vec2& start, const glm::vec2& end, RaycastHit2D& outHit)
+	{
+		if (!_physicsWorld || start == end)
+			return false;
+
+		ClosestRaycastCallback callback;
+		_physicsWorld->RayCast(&callback, b2Vec2(start.x, start.y), b2Vec2(end.x, end.y));
+
+		if (!callback.fixture)
+			return false;
+
+		outHit.entityID = _registry.get<IDComponent>(getFixtureEntity(callback.fixture)).id;
+		outHit.point = { callback.point.x, callback.point.y };
+		outHit.normal = { callback.normal.x, callback.normal.y };
+		outHit.fraction = callback.fraction;
+
+		return true;
+	}
+
+	uint32_t Scene::raycastAll2D(const glm::vec2& start, const glm::vec2& end, std::vector<RaycastHit2D>& outHits)
+	{
+		outHits.clear();
+
+		if (!_physicsWorld || start == end)
+			return 0;
+
+		AllRaycastCallback callback;
+		_physicsWorld->RayCast(&callback, b2Vec2(start.x, start.y), b2Vec2(end.x, end.y));
+
+		// Box2D reports fixtures in broadphase order
+		std::sort(callback.hits.begin(), callback.hits.end(), [](const auto& lhs, const auto& rhs) { return lhs.fraction < rhs.fraction; });
+
+		outHits.reserve(callback.hits.size());
+		for (const auto& hit : callback.hits)
+		{
+			UUID entityID = _registry.get<IDComponent>(getFixtureEntity(hit.fixture)).id;
+			outHits.push_back({ entityID, { hit.point.x, hit.point.y }, { hit.normal.x, hit.normal.y }, hit.fraction });
+		}
+
+		return static_cast<uint32_t>(outHits.size());
+	}
 
-				auto& transform = entity.getComponent<TransformComponent>();
-				auto& rb2d = entity.getComponent<Rigidbody2DComponent>();
+	static uint32_t overlapShape2D(b2World* world, entt::registry& registry, const b2Shape& shape, const b2Transform& transform, std::vector<UUID>& outEntities)
+	{
+		outEntities.clear();
+
+		if (!world)
+			return 0;
+
+		b2AABB aabb;
+		shape.ComputeAABB(&aabb, transform, 0);
+
+		std::vector<b2Fixture*> fixtures;
+		OverlapQueryCallback callback(shape, transform, fixtures);
+		world->QueryAABB(&callback, aabb);
+
+		for (b2Fixture* fixture : fixtures)
+		{
+			UUID entityID = registry.get<IDComponent>(getFixtureEntity(fixture)).id;
+
+			// An entity can own both a box and a circle fixture
+			if (std::find(outEntities.begin(), outEntities.end(), entityID) == outEntities.end())
+				outEntities.push_back(entityID);
+		}
+
+		return static_cast<uint32_t>(outEntities.size());
+	}
 
-				b2Body* body = (b2Body*)rb2d.runtimeBody;
-				AZ_CORE_ASSERT(body != nullptr, "Box2D body is not valid");
+	uint32_t Scene::overlapBox2D(const glm::vec2& center, const glm::vec2& halfExtents, float angle, std::vector<UUID>& outEntities)
+	{
+		b2PolygonShape shape;
+		shape.SetAsBox(halfExtents.x, halfExtents.y);
 
-				const auto& position = body->GetPosition();
-				transform.translation.x = position.x;
-				transform.translation.y = position.y;
-				transform.rotation.z = body->GetAngle();
+		b2Transform transform(b2Vec2(center.x, center.y), b2Rot(angle));
+		return overlapShape2D(_physicsWorld, _registry, shape, transform, outEntities);
+	}
+
+	uint32_t Scene::overlapCircle2D(const glm::vec2& center, float radius, std::vector<UUID>& outEntities)
+	{
+		b2CircleShape shape;
+		shape.m_radius = radius;
+
+		b2Transform transform(b2Vec2(center.x, center.y), b2Rot(0.0f));
+		return overlapShape2D(_physicsWorld, _registry, shape, transform, outEntities);
+	}
+
+	static bool shapeCast2D(b2World* world, entt::registry& registry, const b2Shape& shape, const b2Transform& transform, const glm::vec2& translation, RaycastHit2D& outHit)
+	{
+		if (!world)
+			return false;
+
+		// Everything the shape can touch lies within the bounds of its start and end positions
+		b2Transform endTransform(transform.p + b2Vec2(translation.x, translation.y), transform.q);
+
+		b2AABB startBounds, endBounds, sweptBounds;
+		shape.ComputeAABB(&startBounds, transform, 0);
+		shape.ComputeAABB(&endBounds, endTransform, 0);
+		sweptBounds.Combine(startBounds, endBounds);
+
+		std::vector<b2Fixture*> fixtures;
+		CandidateQueryCallback callback(fixtures);
+		world->QueryAABB(&callback, sweptBounds);
+
+		b2ShapeCastInput input;
+		input.proxyB.Set(&shape, 0);
+		input.transformB = transform;
+		input.translationB.Set(translation.x, translation.y);
+
+		b2Fixture* closestFixture = nullptr;
+		b2ShapeCastOutput closestOutput;
+		closestOutput.lambda = 1.0f;
+
+		for (b2Fixture* fixture : fixtures)
+		{
+			input.proxyA.Set(fixture->GetShape(), 0);
+			input.transformA = fixture->GetBody()->GetTransform();
+
+			b2ShapeCastOutput output;
+			if (b2ShapeCast(&output, &input) && output.lambda <= closestOutput.lambda)
+			{
+				closestFixture = fixture;
+				closestOutput = output;
 			}
 		}
+
+		if (!closestFixture)
+			return false;
+
+		outHit.entityID = registry.get<IDComponent>(getFixtureEntity(closestFixture)).id;
+		outHit.point = { closestOutput.point.x, closestOutput.point.y };
+		outHit.normal = { closestOutput.normal.x, closestOutput.normal.y };
+		outHit.fraction = closestOutput.lambda;
+
+		return true;
+	}
+
+	bool Scene::boxCast2D(const glm::vec2& center, const glm::vec2& halfExtents, float angle, const glm::vec2& translation, RaycastHit2D& outHit)
+	{
+		b2PolygonShape shape;
+		shape.SetAsBox(halfExtents.x, halfExtents.y);
+
+		b2Transform transform(b2Vec2(center.x, center.y), b2Rot(angle));
+		return shapeCast2D(_physicsWorld, _registry, shape, transform, translation, outHit);
+	}
+
+	bool Scene::circleCast2D(const glm::vec2& center, float radius, const glm::vec2& translation, RaycastHit2D& outHit)
+	{
+		b2CircleShape shape;
+		shape.m_radius = radius;
+
+		b2Transform transform(b2Vec2(center.x, center.y), b2Rot(0.0f));
+		return shapeCast2D(_physicsWorld, _registry, shape, transform, translation, outHit);
 	}
 
 	void Scene::onUpdateScriptComponents(Timestep ts)
@@ -385,6 +1110,51 @@ namespace Azteck
 		}
 	}
 
+	void Scene::onUpdateParticles(Timestep ts)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		auto view = _registry.view<TransformComponent, ParticleEmitterComponent>();
+		_particleEmitters.assign(view.begin(), view.end());
+
+		_particleVertices.resize(JobSystem::getMaxPartitions());
+		for (auto& vertices : _particleVertices)
+			vertices.clear();
+
+		// Every emitter owns its pool and random state, so emitters update independently.
+		// Each partition writes its quads into its own buffer, merged in order by renderParticles
+		JobSystem::parallelFor((uint32_t)_particleEmitters.size(), 4, [&](uint32_t begin, uint32_t end, uint32_t partition)
+			{
+				auto& vertices = _particleVertices[partition];
+
+				for (uint32_t i = begin; i < end; i++)
+				{
+					entt::entity entity = _particleEmitters[i];
+					auto& emitter = view.get<ParticleEmitterComponent>(entity);
+					const glm::vec3 position = getWorldTransform(entity)[3];
+					const ParticleProps& props = emitter.props;
+
+					if (!emitter.runtimePool)
+						emitter.runtimePool = createRef<ParticlePool>(props.maxParticles);
+					else if (emitter.runtimePool->getCapacity() != props.maxParticles)
+						emitter.runtimePool->setCapacity(props.maxParticles);
+
+					emitter.runtimePool->update(ts, props.acceleration);
+
+					if (emitter.emitting)
+					{
+						emitter.runtimeEmissionAccumulator += ts * props.emissionRate;
+						uint32_t count = static_cast<uint32_t>(emitter.runtimeEmissionAccumulator);
+						emitter.runtimeEmissionAccumulator -= count;
+
+						emitter.runtimePool->emit(props, { position.x, position.y }, count);
+					}
+
+					Renderer2D::buildParticleVertices(*emitter.runtimePool, props, position.z, static_cast<int>(entity), vertices);
+				}
+			});
+	}
+
 	void Scene::onUpdateNativeScriptComponents(Timestep ts)
 	{
 		getAllEntitiesWith<NativeScriptComponent>().each([=](auto entity, NativeScriptComponent& nsc)
@@ -402,25 +1172,255 @@ namespace Azteck
 			});
 	}
 
-	void Scene::renderScene(EditorCamera& camera)
+	void Scene::onSpriteRendererChanged(entt::registry& registry, entt::entity entity)
 	{
-		Renderer2D::beginScene(camera);
+		// Dynamic sprites never touch the batches, the baked set catches sprites that stopped being static.
+		// On destroy the component is still there to check
+		const auto& sprite = registry.get<SpriteRendererComponent>(entity);
+		if (sprite.isStatic || _bakedStaticSprites.count(entity))
+			_staticBatchesDirty = true;
+	}
+
+	void Scene::onTransformUpdate(entt::registry& registry, entt::entity entity)
+	{
+		markTransformDirty(entity);
+	}
+
+	void Scene::onRelationshipConstruct(entt::registry& registry, entt::entity entity)
+	{
+		// A new root can go anywhere in the storage, only links copied in with the component need a rebuild
+		auto& relationship = registry.get<RelationshipComponent>(entity);
+		if (relationship.parent || !relationship.children.empty())
+			_hierarchyDirty = true;
+
+		relationship.runtimeDirty = true;
+		_dirtyTransforms.push_back(entity);
+		_hierarchyVersion++;
+	}
+
+	void Scene::onRelationshipDestroy(entt::registry& registry, entt::entity entity)
+	{
+		// destroyEntity removes children first, anything left over still points here
+		for (UUID child : registry.get<RelationshipComponent>(entity).children)
+		{
+			if (getEntityByUUID(child))
+			{
+				_hierarchyDirty = true;
+				break;
+			}
+		}
+
+		_hierarchyVersion++;
+	}
+
+	void Scene::onTagConstruct(entt::registry& registry, entt::entity entity)
+	{
+		size_t hash = std::hash<std::string_view>{}(registry.get<TagComponent>(entity).tag);
+		_nameIndex.emplace(hash, entity);
+		_entityNameHashes[entity] = hash;
+	}
+
+	void Scene::onTagUpdate(entt::registry& registry, entt::entity entity)
+	{
+		onTagDestroy(registry, entity);
+		onTagConstruct(registry, entity);
+	}
+
+	void Scene::onTagDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto hashIt = _entityNameHashes.find(entity);
+		if (hashIt == _entityNameHashes.end())
+			return;
 
+		auto [begin, end] = _nameIndex.equal_range(hashIt->second);
+		for (auto it = begin; it != end; ++it)
 		{
+			if (it->second == entity)
+			{
+				_nameIndex.erase(it);
+				break;
+			}
+		}
+
+		_entityNameHashes.erase(hashIt);
+	}
+
+	// Conservative test, a rect is only culled when all corners are outside of the same clip plane
+	static bool isRectVisible(const glm::mat4& mvp, const glm::vec2& min, const glm::vec2& max)
+	{
+		const glm::vec4 corners[4] = {
+			mvp * glm::vec4(min.x, min.y, 0.0f, 1.0f),
+			mvp * glm::vec4(max.x, min.y, 0.0f, 1.0f),
+			mvp * glm::vec4(max.x, max.y, 0.0f, 1.0f),
+			mvp * glm::vec4(min.x, max.y, 0.0f, 1.0f)
+		};
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			bool allBelow = true;
+			bool allAbove = true;
+			for (const auto& corner : corners)
+			{
+				allBelow &= corner[axis] < -corner.w;
+				allAbove &= corner[axis] > corner.w;
+			}
+
+			if (allBelow || allAbove)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void buildTilemapChunk(TilemapComponent& tilemap, const glm::mat4& transform, uint32_t chunkX, uint32_t chunkY, int entityID)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		std::vector<Renderer2D::StaticQuad> quads;
+		quads.reserve(TilemapComponent::chunkSize * TilemapComponent::chunkSize);
+
+		const uint32_t beginX = chunkX * TilemapComponent::chunkSize;
+		const uint32_t beginY = chunkY * TilemapComponent::chunkSize;
+		const uint32_t endX = std::min(beginX + TilemapComponent::chunkSize, tilemap.width);
+		const uint32_t endY = std::min(beginY + TilemapComponent::chunkSize, tilemap.height);
+
+		const uint32_t columns = std::max(tilemap.tilesetColumns, 1u);
+		const uint32_t rows = std::max(tilemap.tilesetRows, 1u);
+		const glm::vec2 tileUVSize = { 1.0f / columns, 1.0f / rows };
+
+		for (uint32_t y = beginY; y < endY; y++)
+		{
+			for (uint32_t x = beginX; x < endX; x++)
+			{
+				uint16_t tile = tilemap.tiles[y * tilemap.width + x];
+				if (tile == 0)
+					continue;
+
+				glm::vec2 center = (glm::vec2(x, y) + 0.5f) * tilemap.tileSize;
+				glm::mat4 tileTransform = transform
+					* glm::translate(glm::mat4(1.0f), glm::vec3(center, 0.0f))
+					* glm::scale(glm::mat4(1.0f), glm::vec3(tilemap.tileSize, 1.0f));
+
+				// Tileset rows are counted from the top of the texture
+				uint32_t index = tile - 1u;
+				glm::vec2 cell = { (float)(index % columns), (float)(rows - 1 - (index / columns) % rows) };
+
+				Renderer2D::StaticQuad& quad = quads.emplace_back();
+				quad.transform = tileTransform;
+				quad.color = tilemap.color;
+				quad.texture = tilemap.tileset;
+				quad.tilingFactor = 1.0f;
+				quad.entityID = entityID;
+				quad.texCoordMin = cell * tileUVSize;
+				quad.texCoordMax = (cell + 1.0f) * tileUVSize;
+			}
+		}
+
+		// A full chunk with a single tileset always fits one batch
+		std::vector<Ref<StaticBatch2D>> batches;
+		Renderer2D::createStaticBatches(quads, batches);
+
+		TilemapComponent::Chunk& chunk = tilemap.runtimeChunks[chunkY * tilemap.getChunkColumns() + chunkX];
+		chunk.batch = batches.empty() ? nullptr : std::move(batches[0]);
+		chunk.dirty = false;
+	}
+
+	void Scene::renderTilemaps()
+	{
+		const glm::mat4& viewProjection = Renderer2D::getViewProjection();
+
+		auto view = getAllEntitiesWith<TransformComponent, TilemapComponent>();
+		for (auto entity : view)
+		{
+			auto& tilemap = view.get<TilemapComponent>(entity);
+			if (tilemap.tiles.empty())
+				continue;
+
+			// Chunks are baked in world space
+			const glm::mat4& transform = getWorldTransform(entity);
+			if (tilemap.runtimeTransform != transform || tilemap.runtimeChunks.size() != tilemap.getChunkColumns() * tilemap.getChunkRows())
+			{
+				tilemap.runtimeTransform = transform;
+				tilemap.invalidate();
+			}
+
+			const glm::mat4 mvp = viewProjection * transform;
+			const glm::vec2 chunkExtent = tilemap.tileSize * (float)TilemapComponent::chunkSize;
+
+			for (uint32_t chunkY = 0; chunkY < tilemap.getChunkRows(); chunkY++)
+			{
+				for (uint32_t chunkX = 0; chunkX < tilemap.getChunkColumns(); chunkX++)
+				{
+					glm::vec2 min = glm::vec2(chunkX, chunkY) * chunkExtent;
+					if (!isRectVisible(mvp, min, min + chunkExtent))
+						continue;
+
+					// Chunks are only built once they become visible
+					TilemapComponent::Chunk& chunk = tilemap.runtimeChunks[chunkY * tilemap.getChunkColumns() + chunkX];
+					if (chunk.dirty)
+						buildTilemapChunk(tilemap, transform, chunkX, chunkY, static_cast<int>(entity));
+
+					if (chunk.batch)
+						Renderer2D::drawStaticBatch(chunk.batch);
+				}
+			}
+		}
+	}
+
+	void Scene::renderSprites()
+	{
+		if (_staticBatchesDirty)
+		{
+			std::vector<Renderer2D::StaticQuad> quads;
+			_bakedStaticSprites.clear();
+
 			auto view = getAllEntitiesWith<TransformComponent, SpriteRendererComponent>();
 			for (auto entity : view)
 			{
-				auto [transform, sprite] = view.get<TransformComponent, SpriteRendererComponent>(entity);
-				Renderer2D::drawSprite(transform.getTransform(), sprite, static_cast<int>(entity));
+				auto& sprite = view.get<SpriteRendererComponent>(entity);
+				if (sprite.isStatic)
+				{
+					quads.push_back({ getWorldTransform(entity), sprite.color, sprite.texture, sprite.tilingFactor, static_cast<int>(entity) });
+					_bakedStaticSprites.insert(entity);
+				}
 			}
+
+			Renderer2D::createStaticBatches(quads, _staticBatches);
+			_staticBatchesDirty = false;
 		}
 
+		for (const auto& batch : _staticBatches)
+			Renderer2D::drawStaticBatch(batch);
+
+		auto view = getAllEntitiesWith<TransformComponent, SpriteRendererComponent>();
+		for (auto entity : view)
+		{
+			auto& sprite = view.get<SpriteRendererComponent>(entity);
+			if (!sprite.isStatic)
+				Renderer2D::drawSprite(getWorldTransform(entity), sprite, static_cast<int>(entity));
+		}
+	}
+
+	void Scene::renderParticles()
+	{
+		for (const auto& vertices : _particleVertices)
+			Renderer2D::drawQuadVertices(vertices.data(), (uint32_t)(vertices.size() / 4));
+	}
+
+	void Scene::renderScene(EditorCamera& camera)
+	{
+		Renderer2D::beginScene(camera);
+
+		renderTilemaps();
+		renderSprites();
+		renderParticles();
+
 		{
 			auto view = getAllEntitiesWith<TransformComponent, CircleRendererComponent>();
 			for (auto entity : view)
 			{
-				auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-				Renderer2D::drawCircle(transform.getTransform(), circle.color, circle.thickness, circle.fade, static_cast<int>(entity));
+				auto& circle = view.get<CircleRendererComponent>(entity);
+				Renderer2D::drawCircle(getWorldTransform(entity), circle.color, circle.thickness, circle.fade, static_cast<int>(entity));
 			}
 		}
 
@@ -428,8 +1428,8 @@ namespace Azteck
 			auto view = getAllEntitiesWith<TransformComponent, TextComponent>();
 			for (auto entity : view)
 			{
-				auto [transform, text] = view.get<TransformComponent, TextComponent>(entity);
-				Renderer2D::drawString(text.textString, transform.getTransform(), text, static_cast<int>(entity));
+				auto& text = view.get<TextComponent>(entity);
+				Renderer2D::drawString(getWorldTransform(entity), text, static_cast<int>(entity));
 			}
 		}
 
@@ -448,6 +1448,11 @@ namespace Azteck
 	{
 	}
 
+	template<>
+	void Scene::onComponentAdded<RelationshipComponent>(Entity entity, RelationshipComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::onComponentAdded<CameraComponent>(Entity entity, CameraComponent& component)
 	{
@@ -499,4 +1504,14 @@ namespace Azteck
 	void Scene::onComponentAdded<TextComponent>(Entity entity, TextComponent& component)
 	{
 	}
+
+	template<>
+	void Scene::onComponentAdded<TilemapComponent>(Entity entity, TilemapComponent& component)
+	{
+	}
+
+	template<>
+	void Scene::onComponentAdded<ParticleEmitterComponent>(Entity entity, ParticleEmitterComponent& component)
+	{
+	}
 }
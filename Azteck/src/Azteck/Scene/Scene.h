@@ -5,11 +5,37 @@
 #include "Azteck/Core/Timestep.h"
 #include "Azteck/Core/UUID.h"
 #include "Azteck/Renderer/EditorCamera.h"
+#include "Azteck/Renderer/Renderer2DVertices.h"
 
 class b2World;
 
 namespace Azteck
 {
+	class Physics2DContactListener;
+	class StaticBatch2D;
+
+	struct Physics2DSettings
+	{
+		// Physics always advances in steps of this size, independent of the frame rate
+		float fixedTimestep = 1.0f / 60.0f;
+		// Upper bound of steps per frame, the remaining time is dropped
+		int maxSubsteps = 8;
+
+		int velocityIterations = 6;
+		int positionIterations = 2;
+
+		// Blend rendered transforms between the two latest physics states
+		bool interpolation = true;
+	};
+
+	struct RaycastHit2D
+	{
+		UUID entityID = 0;
+		glm::vec2 point{ 0.0f };
+		glm::vec2 normal{ 0.0f };
+		float fraction = 0.0f;
+	};
+
 	class Scene
 	{
 		friend class Entity;
@@ -37,17 +63,58 @@ namespace Azteck
 
 		void step(int frames = 1);
 
+		const Physics2DSettings& getPhysics2DSettings() const { return _physics2DSettings; }
+		void setPhysics2DSettings(const Physics2DSettings& settings) { _physics2DSettings = settings; }
+
+		// Physics queries, they only report hits while physics is running
+		bool raycast2D(const glm::vec2& start, const glm::vec2& end, RaycastHit2D& outHit);
+		uint32_t raycastAll2D(const glm::vec2& start, const glm::vec2& end, std::vector<RaycastHit2D>& outHits);
+		uint32_t overlapBox2D(const glm::vec2& center, const glm::vec2& halfExtents, float angle, std::vector<UUID>& outEntities);
+		uint32_t overlapCircle2D(const glm::vec2& center, float radius, std::vector<UUID>& outEntities);
+		bool boxCast2D(const glm::vec2& center, const glm::vec2& halfExtents, float angle, const glm::vec2& translation, RaycastHit2D& outHit);
+		bool circleCast2D(const glm::vec2& center, float radius, const glm::vec2& translation, RaycastHit2D& outHit);
+
 		void onUpdateRuntime(Timestep ts);
 		void onUpdateSimulation(Timestep ts, EditorCamera& camera);
 		void onUpdateEditor(Timestep ts, EditorCamera& camera);
+		// Physics and the transform sync alone, no scripts or rendering. Contacts of the step
+		// are dropped, physics has to be started with onSimulationStart or onRuntimeStart
+		void stepPhysics(Timestep ts);
 		void onViewportResize(uint32_t width, uint32_t height);
 
+		// Static sprites are rebuilt on component signals, changes made by writing
+		// to components directly have to be reported here
+		void markStaticBatchesDirty() { _staticBatchesDirty = true; }
+
 		Entity getPrimaryCamera();
 
 		Entity duplicateEntity(Entity entity);
 
+		// Hierarchy. A null parent makes the entity a root, children are destroyed with their parent
+		void setParent(Entity entity, Entity parent);
+		Entity getParent(Entity entity);
+		bool isAncestorOf(Entity ancestor, Entity entity);
+		// Bumped whenever entities are created, destroyed or reparented
+		uint64_t getHierarchyVersion() const { return _hierarchyVersion; }
+
+		// Recomputes the world transforms of dirty entities and their children. After the
+		// hierarchy changed, everything is propagated in one pass over the sorted storage
+		void updateWorldTransforms();
+		const glm::mat4& getWorldTransform(entt::entity entity) const;
+		// Transforms written directly, without patch or replace, have to be reported here
+		void markTransformDirty(entt::entity entity);
+
 		Entity getEntityByUUID(UUID uuid);
+		// Looked up through a name index, first match wins when names repeat
 		Entity getEntityByName(std::string_view name);
+		// Same lookup with the std::hash<std::string_view> of the name computed by the caller
+		Entity getEntityByName(std::string_view name, size_t nameHash);
+		// Renames through the registry so the name index and other listeners see the change
+		void setEntityName(Entity entity, const std::string& name);
+		bool isEntityValid(entt::entity handle) const { return _registry.valid(handle); }
+
+		// CPU side pick of the topmost sprite or circle under a world position
+		Entity pickEntity2D(const glm::vec2& point);
 
 		template<typename... Components>
 		auto getAllEntitiesWith()
@@ -64,10 +131,37 @@ namespace Azteck
 		void onPhysics2DStart();
 		void onPhysics2DStop();
 
+		// Built from the parent chain, the cached world transforms may not have seen this frame's changes yet
+		glm::mat4 computeWorldTransform(entt::entity entity);
+
+		void createPhysicsBody(entt::entity entity);
+		void createPendingPhysicsBodies();
+
+		void onPhysicsComponentConstruct(entt::registry& registry, entt::entity entity);
+		void onRigidbody2DDestroy(entt::registry& registry, entt::entity entity);
+		void onBoxCollider2DDestroy(entt::registry& registry, entt::entity entity);
+		void onCircleCollider2DDestroy(entt::registry& registry, entt::entity entity);
+
 		void onUpdatePhysics(Timestep ts);
 		void onUpdateScriptComponents(Timestep ts);
 		void onUpdateNativeScriptComponents(Timestep ts);
+		void onUpdateParticles(Timestep ts);
+
+		void onSpriteRendererChanged(entt::registry& registry, entt::entity entity);
+		void onTransformUpdate(entt::registry& registry, entt::entity entity);
+
+		void onRelationshipConstruct(entt::registry& registry, entt::entity entity);
+		void onRelationshipDestroy(entt::registry& registry, entt::entity entity);
+		void rebuildHierarchy();
+		void updateWorldTransformSubtree(entt::entity entity);
 
+		void onTagConstruct(entt::registry& registry, entt::entity entity);
+		void onTagUpdate(entt::registry& registry, entt::entity entity);
+		void onTagDestroy(entt::registry& registry, entt::entity entity);
+
+		void renderTilemaps();
+		void renderSprites();
+		void renderParticles();
 		void renderScene(EditorCamera& camera);
 
 	private:
@@ -77,6 +171,26 @@ namespace Azteck
 		uint32_t _viewportHeight;
 
 		b2World* _physicsWorld = nullptr;
+		Physics2DContactListener* _contactListener = nullptr;
+		Physics2DSettings _physics2DSettings;
+		float _physicsAccumulator = 0.0f;
+		// Entities whose body or fixtures have to be created before the next step
+		std::vector<entt::entity> _pendingPhysicsBodies;
+		// Bodies that were awake at the last transform sync
+		std::vector<entt::entity> _awakeBodies;
+
+		std::vector<Ref<StaticBatch2D>> _staticBatches;
+		// Sprites in _staticBatches, so turning isStatic off still rebakes
+		std::unordered_set<entt::entity> _bakedStaticSprites;
+		bool _staticBatchesDirty = true;
+
+		bool _hierarchyDirty = true;
+		uint64_t _hierarchyVersion = 0;
+		std::vector<entt::entity> _dirtyTransforms;
+
+		// Particle quads built during the update, one buffer per job partition
+		std::vector<entt::entity> _particleEmitters;
+		std::vector<std::vector<QuadVertex>> _particleVertices;
 
 		bool _isRunning;
 		bool _isPaused;
@@ -84,5 +198,9 @@ namespace Azteck
 		int _stepFrames;
 
 		std::unordered_map<UUID, entt::entity> _entityMap;
+
+		// Name hash to entities, with the hash each entity was indexed under for removal
+		std::unordered_multimap<size_t, entt::entity> _nameIndex;
+		std::unordered_map<entt::entity, size_t> _entityNameHashes;
 	};
 }
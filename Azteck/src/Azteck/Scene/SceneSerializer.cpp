@@ -142,6 +142,102 @@ namespace Azteck
 		return out;
 	}
 
+	namespace Utils
+	{
+		static const char* base64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		static std::string encodeBase64(const std::vector<uint8_t>& data)
+		{
+			std::string result;
+			result.reserve((data.size() + 2) / 3 * 4);
+
+			for (size_t i = 0; i < data.size(); i += 3)
+			{
+				uint32_t chunk = data[i] << 16;
+				if (i + 1 < data.size()) chunk |= data[i + 1] << 8;
+				if (i + 2 < data.size()) chunk |= data[i + 2];
+
+				result.push_back(base64Alphabet[(chunk >> 18) & 0x3F]);
+				result.push_back(base64Alphabet[(chunk >> 12) & 0x3F]);
+				result.push_back(i + 1 < data.size() ? base64Alphabet[(chunk >> 6) & 0x3F] : '=');
+				result.push_back(i + 2 < data.size() ? base64Alphabet[chunk & 0x3F] : '=');
+			}
+
+			return result;
+		}
+
+		static std::vector<uint8_t> decodeBase64(const std::string& text)
+		{
+			uint8_t lookup[256];
+			memset(lookup, 0xFF, sizeof(lookup));
+			for (uint8_t i = 0; i < 64; i++)
+				lookup[(uint8_t)base64Alphabet[i]] = i;
+
+			std::vector<uint8_t> result;
+			result.reserve(text.size() / 4 * 3);
+
+			uint32_t chunk = 0;
+			int bits = 0;
+			for (char c : text)
+			{
+				uint8_t value = lookup[(uint8_t)c];
+				if (value == 0xFF)
+					continue;
+
+				chunk = (chunk << 6) | value;
+				bits += 6;
+				if (bits >= 8)
+				{
+					bits -= 8;
+					result.push_back((uint8_t)(chunk >> bits));
+				}
+			}
+
+			return result;
+		}
+
+		// Tiles are stored as little endian (run length, tile) pairs of 16 bits each,
+		// so large empty or filled areas take a few bytes
+		static std::string encodeTiles(const std::vector<uint16_t>& tiles)
+		{
+			std::vector<uint8_t> data;
+
+			for (size_t i = 0; i < tiles.size();)
+			{
+				uint16_t tile = tiles[i];
+				uint16_t run = 0;
+				while (i < tiles.size() && tiles[i] == tile && run < UINT16_MAX)
+				{
+					run++;
+					i++;
+				}
+
+				data.push_back((uint8_t)run);
+				data.push_back((uint8_t)(run >> 8));
+				data.push_back((uint8_t)tile);
+				data.push_back((uint8_t)(tile >> 8));
+			}
+
+			return encodeBase64(data);
+		}
+
+		static void decodeTiles(const std::string& text, std::vector<uint16_t>& tiles)
+		{
+			std::vector<uint8_t> data = decodeBase64(text);
+
+			size_t index = 0;
+			for (size_t i = 0; i + 3 < data.size() && index < tiles.size(); i += 4)
+			{
+				uint16_t run = data[i] | (data[i + 1] << 8);
+				uint16_t tile = data[i + 2] | (data[i + 3] << 8);
+
+				size_t end = std::min(index + run, tiles.size());
+				std::fill(tiles.begin() + index, tiles.begin() + end, tile);
+				index = end;
+			}
+		}
+	}
+
 	static std::string rigidBody2DTypeToString(Rigidbody2DComponent::BodyType type)
 	{
 		switch (type)
@@ -230,6 +326,9 @@ namespace Azteck
 			return false;
 		}
 
+		// Parents may come after their children in the file, so links are made once all entities exist
+		std::vector<std::pair<UUID, UUID>> parentLinks;
+
 		for (auto entity : entities)
 		{
 			uint64_t uuid = entity["Entity"].as<uint64_t>();
@@ -252,6 +351,9 @@ namespace Azteck
 				tc.scale = transformComponent["Scale"].as<glm::vec3>();
 			}
 
+			if (auto relationshipComponent = entity["RelationshipComponent"])
+				parentLinks.emplace_back(uuid, relationshipComponent["Parent"].as<uint64_t>());
+
 			if (auto cameraComponent = entity["CameraComponent"])
 			{
 				auto& cc = deserializedEntity.addComponent<CameraComponent>();
@@ -276,7 +378,8 @@ namespace Azteck
 				auto& sc = deserializedEntity.addComponent<ScriptComponent>();
 				sc.className = scriptComponent["ClassName"].as<std::string>();
 
-				if (auto scriptFields = scriptComponent["ScriptFields"])
+				auto scriptFields = scriptComponent["ScriptFields"];
+				if (scriptFields && _loadScriptFields)
 				{
 					if (Ref<ScriptClass> entityClass = ScriptEngine::getEntityClass(sc.className))
 					{
@@ -334,6 +437,14 @@ namespace Azteck
 					//auto path = Project::getAssetFileSystemPath(texturePath);
 					src.texture = Texture2D::create(texturePath);
 				}
+
+				// Set after construction, the signal only saw a dynamic sprite
+				if (spriteRenderComponent["Static"])
+				{
+					src.isStatic = spriteRenderComponent["Static"].as<bool>();
+					if (src.isStatic)
+						_scene->markStaticBatchesDirty();
+				}
 			}
 
 			if (auto circleRenderComponent = entity["CircleRendererComponent"])
@@ -360,6 +471,9 @@ namespace Azteck
 				bc2d.friction = boxCollider2DComponent["Friction"].as<float>();
 				bc2d.restitution = boxCollider2DComponent["Restitution"].as<float>();
 				bc2d.restitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
+
+				if (boxCollider2DComponent["IsTrigger"])
+					bc2d.isTrigger = boxCollider2DComponent["IsTrigger"].as<bool>();
 			}
 
 			if (auto circleCollider2DComponent = entity["CircleCollider2DComponent"])
@@ -371,6 +485,9 @@ namespace Azteck
 				cc2d.friction = circleCollider2DComponent["Friction"].as<float>();
 				cc2d.restitution = circleCollider2DComponent["Restitution"].as<float>();
 				cc2d.restitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
+
+				if (circleCollider2DComponent["IsTrigger"])
+					cc2d.isTrigger = circleCollider2DComponent["IsTrigger"].as<bool>();
 			}
 
 			if (auto textComponent = entity["TextComponent"])
@@ -382,6 +499,52 @@ namespace Azteck
 				tc.kerning = textComponent["Kerning"].as<float>();
 				tc.lineSpacing = textComponent["LineSpacing"].as<float>();
 			}
+
+			if (auto tilemapComponent = entity["TilemapComponent"])
+			{
+				auto& tmc = deserializedEntity.addComponent<TilemapComponent>();
+				tmc.tileSize = tilemapComponent["TileSize"].as<glm::vec2>();
+				tmc.color = tilemapComponent["Color"].as<glm::vec4>();
+				tmc.tilesetColumns = tilemapComponent["TilesetColumns"].as<uint32_t>();
+				tmc.tilesetRows = tilemapComponent["TilesetRows"].as<uint32_t>();
+
+				if (tilemapComponent["TilesetPath"])
+					tmc.tileset = Texture2D::create(tilemapComponent["TilesetPath"].as<std::string>());
+
+				tmc.resize(tilemapComponent["Width"].as<uint32_t>(), tilemapComponent["Height"].as<uint32_t>());
+				Utils::decodeTiles(tilemapComponent["Tiles"].as<std::string>(), tmc.tiles);
+			}
+
+			if (auto particleEmitterComponent = entity["ParticleEmitterComponent"])
+			{
+				auto& pec = deserializedEntity.addComponent<ParticleEmitterComponent>();
+				pec.emitting = particleEmitterComponent["Emitting"].as<bool>();
+
+				auto& props = pec.props;
+				props.emissionRate = particleEmitterComponent["EmissionRate"].as<float>();
+				props.maxParticles = particleEmitterComponent["MaxParticles"].as<uint32_t>();
+				props.lifetime = particleEmitterComponent["Lifetime"].as<float>();
+				props.lifetimeVariation = particleEmitterComponent["LifetimeVariation"].as<float>();
+				props.velocity = particleEmitterComponent["Velocity"].as<glm::vec2>();
+				props.velocityVariation = particleEmitterComponent["VelocityVariation"].as<glm::vec2>();
+				props.acceleration = particleEmitterComponent["Acceleration"].as<glm::vec2>();
+				props.colorBegin = particleEmitterComponent["ColorBegin"].as<glm::vec4>();
+				props.colorEnd = particleEmitterComponent["ColorEnd"].as<glm::vec4>();
+				props.sizeBegin = particleEmitterComponent["SizeBegin"].as<float>();
+				props.sizeEnd = particleEmitterComponent["SizeEnd"].as<float>();
+			}
+		}
+
+		for (const auto& [child, parent] : parentLinks)
+		{
+			Entity parentEntity = _scene->getEntityByUUID(parent);
+			if (!parentEntity)
+			{
+				AZ_CORE_WARN("Parent {0} of entity {1} doesn`t exist", (uint64_t)parent, (uint64_t)child);
+				continue;
+			}
+
+			_scene->setParent(_scene->getEntityByUUID(child), parentEntity);
 		}
 
 		return true;
@@ -424,6 +587,17 @@ namespace Azteck
 			out << YAML::EndMap;
 		}
 
+		// Children are rebuilt from the parents when loading
+		if (entity.hasComponent<RelationshipComponent>() && entity.getComponent<RelationshipComponent>().parent)
+		{
+			out << YAML::Key << "RelationshipComponent";
+			out << YAML::BeginMap;
+
+			out << YAML::Key << "Parent" << YAML::Value << entity.getComponent<RelationshipComponent>().parent;
+
+			out << YAML::EndMap;
+		}
+
 		if (entity.hasComponent<CameraComponent>())
 		{
 			out << YAML::Key << "CameraComponent";
@@ -518,6 +692,8 @@ namespace Azteck
 			if (spriteRendererComponent.texture)
 				out << YAML::Key << "TexturePath" << YAML::Value << spriteRendererComponent.texture->getPath();
 
+			out << YAML::Key << "Static" << YAML::Value << spriteRendererComponent.isStatic;
+
 			out << YAML::EndMap;
 		}
 
@@ -558,6 +734,7 @@ namespace Azteck
 			out << YAML::Key << "Friction" << YAML::Value << bc2dComponent.friction;
 			out << YAML::Key << "Restitution" << YAML::Value << bc2dComponent.restitution;
 			out << YAML::Key << "RestitutionThreshold" << YAML::Value << bc2dComponent.restitutionThreshold;
+			out << YAML::Key << "IsTrigger" << YAML::Value << bc2dComponent.isTrigger;
 
 			out << YAML::EndMap;
 		}
@@ -574,6 +751,7 @@ namespace Azteck
 			out << YAML::Key << "Friction" << YAML::Value << cc2dComponent.friction;
 			out << YAML::Key << "Restitution" << YAML::Value << cc2dComponent.restitution;
 			out << YAML::Key << "RestitutionThreshold" << YAML::Value << cc2dComponent.restitutionThreshold;
+			out << YAML::Key << "IsTrigger" << YAML::Value << cc2dComponent.isTrigger;
 
 			out << YAML::EndMap;
 		}
@@ -593,6 +771,50 @@ namespace Azteck
 			out << YAML::EndMap;
 		}
 
+		if (entity.hasComponent<TilemapComponent>())
+		{
+			out << YAML::Key << "TilemapComponent";
+			out << YAML::BeginMap;
+
+			auto& tilemapComponent = entity.getComponent<TilemapComponent>();
+			out << YAML::Key << "Width" << YAML::Value << tilemapComponent.width;
+			out << YAML::Key << "Height" << YAML::Value << tilemapComponent.height;
+			out << YAML::Key << "TileSize" << YAML::Value << tilemapComponent.tileSize;
+			out << YAML::Key << "Color" << YAML::Value << tilemapComponent.color;
+			out << YAML::Key << "TilesetColumns" << YAML::Value << tilemapComponent.tilesetColumns;
+			out << YAML::Key << "TilesetRows" << YAML::Value << tilemapComponent.tilesetRows;
+
+			if (tilemapComponent.tileset)
+				out << YAML::Key << "TilesetPath" << YAML::Value << tilemapComponent.tileset->getPath();
+
+			out << YAML::Key << "Tiles" << YAML::Value << Utils::encodeTiles(tilemapComponent.tiles);
+
+			out << YAML::EndMap;
+		}
+
+		if (entity.hasComponent<ParticleEmitterComponent>())
+		{
+			out << YAML::Key << "ParticleEmitterComponent";
+			out << YAML::BeginMap;
+
+			auto& particleEmitterComponent = entity.getComponent<ParticleEmitterComponent>();
+			const auto& props = particleEmitterComponent.props;
+			out << YAML::Key << "Emitting" << YAML::Value << particleEmitterComponent.emitting;
+			out << YAML::Key << "EmissionRate" << YAML::Value << props.emissionRate;
+			out << YAML::Key << "MaxParticles" << YAML::Value << props.maxParticles;
+			out << YAML::Key << "Lifetime" << YAML::Value << props.lifetime;
+			out << YAML::Key << "LifetimeVariation" << YAML::Value << props.lifetimeVariation;
+			out << YAML::Key << "Velocity" << YAML::Value << props.velocity;
+			out << YAML::Key << "VelocityVariation" << YAML::Value << props.velocityVariation;
+			out << YAML::Key << "Acceleration" << YAML::Value << props.acceleration;
+			out << YAML::Key << "ColorBegin" << YAML::Value << props.colorBegin;
+			out << YAML::Key << "ColorEnd" << YAML::Value << props.colorEnd;
+			out << YAML::Key << "SizeBegin" << YAML::Value << props.sizeBegin;
+			out << YAML::Key << "SizeEnd" << YAML::Value << props.sizeEnd;
+
+			out << YAML::EndMap;
+		}
+
 		out << YAML::EndMap;
 	}
 }
@@ -15,7 +15,12 @@ namespace Azteck
 		bool deserialize(const std::string& filepath);
 		bool deserializeRuntime(const std::string& filepath);
 
+		// Script field values live in the script engine and are shared with the open scene,
+		// scenes loaded only to be looked at have to leave them alone
+		void setLoadScriptFields(bool load) { _loadScriptFields = load; }
+
 	private:
 		Ref<Scene> _scene;
+		bool _loadScriptFields = true;
 	};
 }
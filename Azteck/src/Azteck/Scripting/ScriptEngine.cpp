@@ -17,6 +17,7 @@
 #include "Azteck/Core/Buffers.h"
 #include "Azteck/Core/FileSystem.h"
 #include "Azteck/Project/Project.h"
+#include "Azteck/Physics/Physics2DContactListener.h"
 
 namespace Azteck 
 {
@@ -152,6 +153,7 @@ namespace Azteck
 		std::filesystem::path appAssemblyFilepath;
 
 		ScriptClass entityClass;
+		MonoMethod* dispatchContactEventsMethod = nullptr;
 
 		std::unordered_map<std::string, Ref<ScriptClass>> entityClasses;
 		std::unordered_map<UUID, Ref<ScriptInstance>> entityInstances;
@@ -214,6 +216,7 @@ namespace Azteck
 
 		// Retrieve and instantiate class (with constructor)
 		_data->entityClass = ScriptClass("Azteck", "Entity", true);
+		_data->dispatchContactEventsMethod = _data->entityClass.getMethod("DispatchContactEvents", 3);
 	}
 
 	void ScriptEngine::shutdown()
@@ -303,9 +306,11 @@ namespace Azteck
 		loadAssemblyClasses();
 
 		ScriptGlue::registerComponents();
+		ScriptGlue::clearNameHandles();
 
 		// Retrieve and instantiate class
 		_data->entityClass = ScriptClass("Azteck", "Entity", true);
+		_data->dispatchContactEventsMethod = _data->entityClass.getMethod("DispatchContactEvents", 3);
 	}
 
 	void ScriptEngine::onRuntimeStart(Scene* scene)
@@ -354,6 +359,52 @@ namespace Azteck
 		}
 	}
 
+	void ScriptEngine::onContactEvents(const std::vector<Contact2DEvent>& events)
+	{
+		if (events.empty() || !_data->dispatchContactEventsMethod)
+			return;
+
+		struct ContactTarget
+		{
+			MonoObject* instance;
+			UUID other;
+			uint8_t type;
+		};
+
+		// Every contact is reported to both entities, if they have a script
+		static std::vector<ContactTarget> targets;
+		targets.clear();
+
+		for (const auto& contact : events)
+		{
+			auto itA = _data->entityInstances.find(contact.entityA);
+			if (itA != _data->entityInstances.end())
+				targets.push_back({ itA->second->getManagedObject(), contact.entityB, static_cast<uint8_t>(contact.type) });
+
+			auto itB = _data->entityInstances.find(contact.entityB);
+			if (itB != _data->entityInstances.end())
+				targets.push_back({ itB->second->getManagedObject(), contact.entityA, static_cast<uint8_t>(contact.type) });
+		}
+
+		if (targets.empty())
+			return;
+
+		MonoArray* instances = mono_array_new(_data->appDomain, _data->entityClass._monoClass, targets.size());
+		MonoArray* others = mono_array_new(_data->appDomain, mono_get_uint64_class(), targets.size());
+		MonoArray* types = mono_array_new(_data->appDomain, mono_get_byte_class(), targets.size());
+
+		for (size_t i = 0; i < targets.size(); i++)
+		{
+			mono_array_setref(instances, i, targets[i].instance);
+			mono_array_set(others, uint64_t, i, targets[i].other);
+			mono_array_set(types, uint8_t, i, targets[i].type);
+		}
+
+		// A single transition into managed code for the whole frame
+		void* params[] = { instances, others, types };
+		_data->entityClass.invokeMethod(nullptr, _data->dispatchContactEventsMethod, params);
+	}
+
 	Scene* ScriptEngine::getSceneContext()
 	{
 		return _data->SceneContext;
@@ -467,6 +518,17 @@ namespace Azteck
 		return mono_string_new(_data->appDomain, string);
 	}
 
+	MonoArray* ScriptEngine::createUUIDArray(const UUID* uuids, size_t count)
+	{
+		static_assert(sizeof(UUID) == sizeof(uint64_t), "UUID has to match System.UInt64");
+
+		MonoArray* array = mono_array_new(_data->appDomain, mono_get_uint64_class(), count);
+		if (count > 0)
+			memcpy(mono_array_addr(array, uint64_t, 0), uuids, count * sizeof(uint64_t));
+
+		return array;
+	}
+
 	MonoObject* ScriptEngine::instantiateClass(MonoClass* monoClass)
 	{
 		MonoObject* instance = mono_object_new(_data->appDomain, monoClass);
@@ -14,10 +14,13 @@ extern "C" {
 	typedef struct _MonoImage MonoImage;
 	typedef struct _MonoClassField MonoClassField;
 	typedef struct _MonoString MonoString;
+	typedef struct _MonoArray MonoArray;
 }
 
 namespace Azteck 
 {
+	struct Contact2DEvent;
+
 	constexpr int FIELD_VALUE_SIZE = 16;
 
 	enum class ScriptFieldType
@@ -160,6 +163,7 @@ namespace Azteck
 		static bool entityClassExists(const std::string& fullClassName);
 		static void onCreateEntity(Entity entity);
 		static void onUpdateEntity(Entity entity, Timestep ts);
+		static void onContactEvents(const std::vector<Contact2DEvent>& events);
 
 		static Scene* getSceneContext();
 		static Ref<ScriptClass> getEntityClass(const std::string& name);
@@ -173,6 +177,7 @@ namespace Azteck
 		static MonoObject* getManagedInstance(UUID uuid);
 
 		static MonoString* createString(const char* string);
+		static MonoArray* createUUIDArray(const UUID* uuids, size_t count);
 
 	private:
 		static void initMono();
@@ -30,10 +30,67 @@ namespace Azteck
 			mono_free(cStr);
 			return str;
 		}
+
+		// Converts straight from the UTF-16 chars into outString, reusing its capacity
+		static void monoStringToUTF8(MonoString* string, std::string& outString)
+		{
+			const mono_unichar2* chars = mono_string_chars(string);
+			const int length = mono_string_length(string);
+
+			outString.clear();
+			for (int i = 0; i < length; i++)
+			{
+				uint32_t codepoint = chars[i];
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] <= 0xDFFF)
+					codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (chars[++i] - 0xDC00);
+				else if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+					codepoint = 0xFFFD;
+
+				if (codepoint < 0x80)
+				{
+					outString.push_back((char)codepoint);
+				}
+				else if (codepoint < 0x800)
+				{
+					outString.push_back((char)(0xC0 | (codepoint >> 6)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+				else if (codepoint < 0x10000)
+				{
+					outString.push_back((char)(0xE0 | (codepoint >> 12)));
+					outString.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+				else
+				{
+					outString.push_back((char)(0xF0 | (codepoint >> 18)));
+					outString.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+					outString.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+					outString.push_back((char)(0x80 | (codepoint & 0x3F)));
+				}
+			}
+		}
 	}
 
 	static std::unordered_map<MonoType*, std::function<bool(Entity)>> _entityHasComponentFuncs;
 
+	// Reused between physics queries to avoid allocating on every call
+	static std::vector<UUID> _queryEntities;
+	static std::vector<RaycastHit2D> _queryHits;
+
+	// Scratch buffer for names passed in from scripts
+	static std::string _nameBuffer;
+	// Names registered by scripts through EntityName, a handle is the index plus one.
+	// The hash is the one the scene's name index uses, so lookups skip hashing
+	struct EntityNameHandle
+	{
+		std::string name;
+		size_t hash;
+	};
+
+	static std::vector<EntityNameHandle> _entityNameHandles;
+	static std::unordered_map<std::string, uint32_t> _entityNameHandleIndex;
+
 	static Entity getEntityFromScene(UUID entityID)
 	{
 		Scene* scene = ScriptEngine::getSceneContext();
@@ -75,22 +132,69 @@ namespace Azteck
 		return _entityHasComponentFuncs.at(managedType)(entity);
 	}
 
-	static uint64_t Entity_FindEntityByName(MonoString* name)
+	static uint64_t findEntityByName(std::string_view name, size_t nameHash)
 	{
-		char* nameCStr = mono_string_to_utf8(name);
-
 		Scene* scene = ScriptEngine::getSceneContext();
 		AZ_CORE_ASSERT(scene, "Scene is nullptr");
 
-		Entity entity = scene->getEntityByName(nameCStr);
-		mono_free(nameCStr);
-
+		Entity entity = scene->getEntityByName(name, nameHash);
 		if (!entity)
 			return 0;
 
 		return entity.getUUID();
 	}
 
+	static uint64_t Entity_FindEntityByName(MonoString* name)
+	{
+		Utils::monoStringToUTF8(name, _nameBuffer);
+		return findEntityByName(_nameBuffer, std::hash<std::string_view>{}(_nameBuffer));
+	}
+
+	static uint32_t Entity_GetNameHandle(MonoString* name)
+	{
+		Utils::monoStringToUTF8(name, _nameBuffer);
+
+		auto [it, inserted] = _entityNameHandleIndex.try_emplace(_nameBuffer, (uint32_t)_entityNameHandles.size() + 1);
+		if (inserted)
+			_entityNameHandles.push_back({ _nameBuffer, std::hash<std::string_view>{}(_nameBuffer) });
+
+		return it->second;
+	}
+
+	static uint64_t Entity_FindEntityByNameHandle(uint32_t handle)
+	{
+		AZ_CORE_ASSERT(handle > 0 && handle <= _entityNameHandles.size(), "Invalid entity name handle");
+
+		const EntityNameHandle& entry = _entityNameHandles[handle - 1];
+		return findEntityByName(entry.name, entry.hash);
+	}
+
+	static MonoString* Entity_GetName(UUID entityID)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		return ScriptEngine::createString(entity.getName().c_str());
+	}
+
+	static void Entity_SetName(UUID entityID, MonoString* name)
+	{
+		Entity entity = getEntityFromScene(entityID);
+
+		Utils::monoStringToUTF8(name, _nameBuffer);
+		ScriptEngine::getSceneContext()->setEntityName(entity, _nameBuffer);
+	}
+
+	static uint64_t Entity_GetParent(UUID entityID)
+	{
+		Entity parent = ScriptEngine::getSceneContext()->getParent(getEntityFromScene(entityID));
+		return parent ? (uint64_t)parent.getUUID() : 0;
+	}
+
+	static void Entity_SetParent(UUID entityID, UUID parentID)
+	{
+		Scene* scene = ScriptEngine::getSceneContext();
+		scene->setParent(getEntityFromScene(entityID), parentID ? getEntityFromScene(parentID) : Entity());
+	}
+
 	static void TransformComponent_GetTranslation(UUID entityID, glm::vec3* outTranslation)
 	{
 		Entity entity = getEntityFromScene(entityID);
@@ -103,6 +207,7 @@ namespace Azteck
 		Entity entity = getEntityFromScene(entityID);
 
 		entity.getComponent<TransformComponent>().translation = *translation;
+		ScriptEngine::getSceneContext()->markTransformDirty(entity);
 	}
 
 	static void Rigidbody2DComponent_ApplyLinearImpulse(UUID entityID, glm::vec2* impulse, glm::vec2* point, bool wake)
@@ -152,6 +257,78 @@ namespace Azteck
 		body->SetType(Utils::rigidbody2DTypeToBox2DBody(bodyType));
 	}
 
+	static Scene* getSceneContext()
+	{
+		Scene* scene = ScriptEngine::getSceneContext();
+		AZ_CORE_ASSERT(scene, "Scene is nullptr");
+
+		return scene;
+	}
+
+	static bool Physics2D_Raycast(glm::vec2* start, glm::vec2* end, RaycastHit2D* outHit)
+	{
+		*outHit = {};
+		return getSceneContext()->raycast2D(*start, *end, *outHit);
+	}
+
+	static MonoArray* Physics2D_RaycastAll(glm::vec2* start, glm::vec2* end)
+	{
+		getSceneContext()->raycastAll2D(*start, *end, _queryHits);
+
+		_queryEntities.clear();
+		for (const auto& hit : _queryHits)
+			_queryEntities.push_back(hit.entityID);
+
+		return ScriptEngine::createUUIDArray(_queryEntities.data(), _queryEntities.size());
+	}
+
+	static MonoArray* Physics2D_RaycastBatch(MonoArray* starts, MonoArray* ends)
+	{
+		Scene* scene = getSceneContext();
+
+		if (starts == nullptr || ends == nullptr)
+			return ScriptEngine::createUUIDArray(nullptr, 0);
+
+		// Points without a partner are ignored instead of read past the shorter array
+		uintptr_t count = std::min(mono_array_length(starts), mono_array_length(ends));
+
+		// One entity ID per ray, 0 means the ray hit nothing
+		_queryEntities.assign(count, 0);
+
+		for (uintptr_t i = 0; i < count; i++)
+		{
+			RaycastHit2D hit;
+			if (scene->raycast2D(mono_array_get(starts, glm::vec2, i), mono_array_get(ends, glm::vec2, i), hit))
+				_queryEntities[i] = hit.entityID;
+		}
+
+		return ScriptEngine::createUUIDArray(_queryEntities.data(), _queryEntities.size());
+	}
+
+	static MonoArray* Physics2D_OverlapBox(glm::vec2* center, glm::vec2* halfExtents, float angle)
+	{
+		getSceneContext()->overlapBox2D(*center, *halfExtents, angle, _queryEntities);
+		return ScriptEngine::createUUIDArray(_queryEntities.data(), _queryEntities.size());
+	}
+
+	static MonoArray* Physics2D_OverlapCircle(glm::vec2* center, float radius)
+	{
+		getSceneContext()->overlapCircle2D(*center, radius, _queryEntities);
+		return ScriptEngine::createUUIDArray(_queryEntities.data(), _queryEntities.size());
+	}
+
+	static bool Physics2D_BoxCast(glm::vec2* center, glm::vec2* halfExtents, float angle, glm::vec2* translation, RaycastHit2D* outHit)
+	{
+		*outHit = {};
+		return getSceneContext()->boxCast2D(*center, *halfExtents, angle, *translation, *outHit);
+	}
+
+	static bool Physics2D_CircleCast(glm::vec2* center, float radius, glm::vec2* translation, RaycastHit2D* outHit)
+	{
+		*outHit = {};
+		return getSceneContext()->circleCast2D(*center, radius, *translation, *outHit);
+	}
+
 	static MonoString* TextComponent_GetText(UUID entityID)
 	{
 		Entity entity = getEntityFromScene(entityID);
@@ -168,6 +345,23 @@ namespace Azteck
 
 		auto& tc = entity.getComponent<TextComponent>();
 		tc.textString = Utils::monoStringToString(textString);
+		tc.layout.invalidate();
+	}
+
+	static void TextComponent_AppendText(UUID entityID, MonoString* textString)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<TextComponent>(), "Entity doesn`t have Text Component");
+
+		auto& tc = entity.getComponent<TextComponent>();
+		std::string text = Utils::monoStringToString(textString);
+		tc.textString += text;
+
+		// A layout that is up to date continues from where it ended instead of being rebuilt
+		if (tc.layout.isValid(tc.fontAsset, tc.kerning, tc.lineSpacing))
+			tc.layout.append(text);
+		else
+			tc.layout.invalidate();
 	}
 
 	static void TextComponent_GetColor(UUID entityID, glm::vec4* color)
@@ -224,6 +418,68 @@ namespace Azteck
 		tc.lineSpacing = lineSpacing;
 	}
 
+	static uint32_t TilemapComponent_GetWidth(UUID entityID)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<TilemapComponent>(), "Entity doesn`t have Tilemap Component");
+
+		return entity.getComponent<TilemapComponent>().width;
+	}
+
+	static uint32_t TilemapComponent_GetHeight(UUID entityID)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<TilemapComponent>(), "Entity doesn`t have Tilemap Component");
+
+		return entity.getComponent<TilemapComponent>().height;
+	}
+
+	static uint16_t TilemapComponent_GetTile(UUID entityID, uint32_t x, uint32_t y)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<TilemapComponent>(), "Entity doesn`t have Tilemap Component");
+
+		return entity.getComponent<TilemapComponent>().getTile(x, y);
+	}
+
+	static void TilemapComponent_SetTile(UUID entityID, uint32_t x, uint32_t y, uint16_t tile)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<TilemapComponent>(), "Entity doesn`t have Tilemap Component");
+
+		entity.getComponent<TilemapComponent>().setTile(x, y, tile);
+	}
+
+	static bool ParticleEmitterComponent_GetEmitting(UUID entityID)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<ParticleEmitterComponent>(), "Entity doesn`t have Particle Emitter Component");
+
+		return entity.getComponent<ParticleEmitterComponent>().emitting;
+	}
+
+	static void ParticleEmitterComponent_SetEmitting(UUID entityID, bool emitting)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<ParticleEmitterComponent>(), "Entity doesn`t have Particle Emitter Component");
+
+		entity.getComponent<ParticleEmitterComponent>().emitting = emitting;
+	}
+
+	static void ParticleEmitterComponent_Burst(UUID entityID, uint32_t count)
+	{
+		Entity entity = getEntityFromScene(entityID);
+		AZ_CORE_ASSERT(entity.hasComponent<ParticleEmitterComponent>(), "Entity doesn`t have Particle Emitter Component");
+
+		auto& emitter = entity.getComponent<ParticleEmitterComponent>();
+		if (!emitter.runtimePool)
+			emitter.runtimePool = createRef<ParticlePool>(emitter.props.maxParticles);
+
+		// Same position the emitter spawns from in Scene::onUpdateParticles
+		const glm::vec3 position = getSceneContext()->getWorldTransform(entity)[3];
+		emitter.runtimePool->emit(emitter.props, { position.x, position.y }, count);
+	}
+
 	static bool Input_IsKeyDown(KeyCode keycode)
 	{
 		return Input::isKeyPressed(keycode);
@@ -261,6 +517,12 @@ namespace Azteck
 		registerComponent(AllComponents{});
 	}
 
+	void ScriptGlue::clearNameHandles()
+	{
+		_entityNameHandles.clear();
+		_entityNameHandleIndex.clear();
+	}
+
 	void ScriptGlue::registerFunctions()
 	{
 		AZ_ADD_INTERNAL_CALL(NativeLog);
@@ -270,6 +532,12 @@ namespace Azteck
 		AZ_ADD_INTERNAL_CALL(GetScriptInstance);
 		AZ_ADD_INTERNAL_CALL(Entity_HasComponent);
 		AZ_ADD_INTERNAL_CALL(Entity_FindEntityByName);
+		AZ_ADD_INTERNAL_CALL(Entity_GetNameHandle);
+		AZ_ADD_INTERNAL_CALL(Entity_FindEntityByNameHandle);
+		AZ_ADD_INTERNAL_CALL(Entity_GetName);
+		AZ_ADD_INTERNAL_CALL(Entity_SetName);
+		AZ_ADD_INTERNAL_CALL(Entity_GetParent);
+		AZ_ADD_INTERNAL_CALL(Entity_SetParent);
 
 		AZ_ADD_INTERNAL_CALL(TransformComponent_GetTranslation);
 		AZ_ADD_INTERNAL_CALL(TransformComponent_SetTranslation);
@@ -277,8 +545,17 @@ namespace Azteck
 		AZ_ADD_INTERNAL_CALL(Rigidbody2DComponent_ApplyLinearImpulse);
 		AZ_ADD_INTERNAL_CALL(Rigidbody2DComponent_ApplyLinearImpulseToCenter);
 
+		AZ_ADD_INTERNAL_CALL(Physics2D_Raycast);
+		AZ_ADD_INTERNAL_CALL(Physics2D_RaycastAll);
+		AZ_ADD_INTERNAL_CALL(Physics2D_RaycastBatch);
+		AZ_ADD_INTERNAL_CALL(Physics2D_OverlapBox);
+		AZ_ADD_INTERNAL_CALL(Physics2D_OverlapCircle);
+		AZ_ADD_INTERNAL_CALL(Physics2D_BoxCast);
+		AZ_ADD_INTERNAL_CALL(Physics2D_CircleCast);
+
 		AZ_ADD_INTERNAL_CALL(TextComponent_GetText);
 		AZ_ADD_INTERNAL_CALL(TextComponent_SetText);
+		AZ_ADD_INTERNAL_CALL(TextComponent_AppendText);
 		AZ_ADD_INTERNAL_CALL(TextComponent_GetColor);
 		AZ_ADD_INTERNAL_CALL(TextComponent_SetColor);
 		AZ_ADD_INTERNAL_CALL(TextComponent_GetKerning);
@@ -286,6 +563,15 @@ namespace Azteck
 		AZ_ADD_INTERNAL_CALL(TextComponent_GetLineSpacing);
 		AZ_ADD_INTERNAL_CALL(TextComponent_SetLineSpacing);
 
+		AZ_ADD_INTERNAL_CALL(TilemapComponent_GetWidth);
+		AZ_ADD_INTERNAL_CALL(TilemapComponent_GetHeight);
+		AZ_ADD_INTERNAL_CALL(TilemapComponent_GetTile);
+		AZ_ADD_INTERNAL_CALL(TilemapComponent_SetTile);
+
+		AZ_ADD_INTERNAL_CALL(ParticleEmitterComponent_GetEmitting);
+		AZ_ADD_INTERNAL_CALL(ParticleEmitterComponent_SetEmitting);
+		AZ_ADD_INTERNAL_CALL(ParticleEmitterComponent_Burst);
+
 		AZ_ADD_INTERNAL_CALL(Input_IsKeyDown);
 	}
 }
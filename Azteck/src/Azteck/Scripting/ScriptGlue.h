@@ -7,5 +7,8 @@ namespace Azteck
 	public:
 		static void registerFunctions();
 		static void registerComponents();
+
+		// Handles belong to the unloaded domain after a reload
+		static void clearNameHandles();
 	};
 }
@@ -0,0 +1,30 @@
+#include "azpch.h"
+#include "HeadlessBuffer.h"
+#include "RenderRecorder.h"
+
+namespace Azteck
+{
+	HeadlessVertexBuffer::HeadlessVertexBuffer(uint32_t size)
+		: _size(size)
+	{
+	}
+
+	HeadlessVertexBuffer::HeadlessVertexBuffer(float* vertices, uint32_t size)
+		: _size(size)
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::UploadVertices, size, vertices);
+	}
+
+	void HeadlessVertexBuffer::setData(const void* data, uint32_t size)
+	{
+		AZ_CORE_ASSERT(size <= _size, "Vertex data does not fit into the buffer");
+
+		RenderRecorder::record(RenderRecorder::CommandType::UploadVertices, size, data);
+	}
+
+	HeadlessIndexBuffer::HeadlessIndexBuffer(uint32_t* indices, uint32_t count)
+		: _count(count)
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::UploadIndices, count * sizeof(uint32_t), indices);
+	}
+}
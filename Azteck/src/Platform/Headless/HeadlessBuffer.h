@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Azteck/Renderer/Buffer.h"
+
+namespace Azteck
+{
+	class HeadlessVertexBuffer : public VertexBuffer
+	{
+	public:
+		HeadlessVertexBuffer(uint32_t size);
+		HeadlessVertexBuffer(float* vertices, uint32_t size);
+		virtual ~HeadlessVertexBuffer() = default;
+
+		virtual void bind() const override {}
+		virtual void unbind() const override {}
+
+		virtual const BufferLayout& getLayout() const override { return _layout; }
+		virtual void setLayout(const BufferLayout& layout) override { _layout = layout; }
+
+		virtual void setData(const void* data, uint32_t size) override;
+
+	private:
+		uint32_t _size;
+		BufferLayout _layout;
+	};
+
+	class HeadlessIndexBuffer : public IndexBuffer
+	{
+	public:
+		HeadlessIndexBuffer(uint32_t* indices, uint32_t count);
+		virtual ~HeadlessIndexBuffer() = default;
+
+		virtual uint32_t getCount() const override { return _count; }
+
+		virtual void bind() const override {}
+		virtual void unbind() const override {}
+
+	private:
+		uint32_t _count;
+	};
+}
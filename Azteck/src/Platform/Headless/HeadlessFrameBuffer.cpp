@@ -0,0 +1,21 @@
+#include "azpch.h"
+#include "HeadlessFrameBuffer.h"
+
+namespace Azteck
+{
+	HeadlessFrameBuffer::HeadlessFrameBuffer(const FrameBufferSpecification& spec)
+		: _spec(spec)
+	{
+	}
+
+	void HeadlessFrameBuffer::resize(uint32_t width, uint32_t height)
+	{
+		_spec.width = width;
+		_spec.height = height;
+	}
+
+	void HeadlessFrameBuffer::readColorAttachment(uint32_t attachmentIndex, void* outData, uint32_t size)
+	{
+		std::memset(outData, 0, size);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Azteck/Renderer/FrameBuffer.h"
+
+namespace Azteck
+{
+	// Has no attachments to read back, every pixel reads as empty
+	class HeadlessFrameBuffer : public FrameBuffer
+	{
+	public:
+		HeadlessFrameBuffer(const FrameBufferSpecification& spec);
+		virtual ~HeadlessFrameBuffer() = default;
+
+		virtual void bind() override {}
+		virtual void unbind() override {}
+
+		virtual void resize(uint32_t width, uint32_t height) override;
+		virtual int readPixel(uint32_t attachmentIndex, int x, int y) override { return -1; }
+
+		virtual void readPixelAsync(uint32_t attachmentIndex, int x, int y) override {}
+		virtual bool getAsyncPixel(int& outValue) override { return false; }
+
+		virtual void readColorAttachment(uint32_t attachmentIndex, void* outData, uint32_t size) override;
+
+		virtual void clearAttachment(uint32_t attachmentIndex, int value) override {}
+
+		virtual const FrameBufferSpecification& getSpecification() const override { return _spec; };
+		virtual uint32_t getColorAttachmentRendererId(uint32_t index = 0) const override { return 0; };
+
+	private:
+		FrameBufferSpecification _spec;
+	};
+}
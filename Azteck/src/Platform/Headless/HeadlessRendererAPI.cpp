@@ -0,0 +1,45 @@
+#include "azpch.h"
+#include "HeadlessRendererAPI.h"
+#include "RenderRecorder.h"
+
+namespace Azteck
+{
+	void HeadlessRendererAPI::init()
+	{
+		AZ_CORE_INFO("Headless renderer, nothing will be drawn");
+	}
+
+	void HeadlessRendererAPI::setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::SetViewport);
+	}
+
+	void HeadlessRendererAPI::setClearColor(const glm::vec4& color)
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::SetClearColor);
+	}
+
+	void HeadlessRendererAPI::clear()
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::Clear);
+	}
+
+	void HeadlessRendererAPI::drawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		vertexArray->bind();
+
+		uint32_t count = indexCount ? indexCount : vertexArray->getIndexBuffer()->getCount();
+		RenderRecorder::record(RenderRecorder::CommandType::DrawIndexed, count);
+	}
+
+	void HeadlessRendererAPI::drawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	{
+		vertexArray->bind();
+		RenderRecorder::record(RenderRecorder::CommandType::DrawLines, vertexCount);
+	}
+
+	void HeadlessRendererAPI::setLineWidth(float width)
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::SetLineWidth);
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Azteck/Renderer/RendererAPI.h"
+
+namespace Azteck
+{
+	// Draws nothing, every command is counted by the RenderRecorder instead
+	class HeadlessRendererAPI : public RendererAPI
+	{
+	public:
+		void init() override;
+
+		void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void setClearColor(const glm::vec4& color) override;
+		void clear() override;
+
+		void drawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override;
+		void drawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount) override;
+
+		void setLineWidth(float width) override;
+	};
+}
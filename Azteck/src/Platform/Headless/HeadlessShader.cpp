@@ -0,0 +1,26 @@
+#include "azpch.h"
+#include "HeadlessShader.h"
+#include "RenderRecorder.h"
+
+namespace Azteck
+{
+	HeadlessShader::HeadlessShader(const std::string& filepath)
+	{
+		size_t lastSlashPos = filepath.find_last_of("/\\");
+		lastSlashPos = lastSlashPos == std::string::npos ? 0 : lastSlashPos + 1;
+
+		size_t lastDot = filepath.rfind('.');
+		size_t count = lastDot == std::string::npos ? filepath.size() - lastSlashPos : lastDot - lastSlashPos;
+		_name = filepath.substr(lastSlashPos, count);
+	}
+
+	HeadlessShader::HeadlessShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+		: _name(name)
+	{
+	}
+
+	void HeadlessShader::bind() const
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::BindShader);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Azteck/Renderer/Shader.h"
+
+namespace Azteck
+{
+	// Keeps only the name, sources are neither read nor compiled
+	class HeadlessShader : public Shader
+	{
+	public:
+		HeadlessShader(const std::string& filepath);
+		HeadlessShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+		virtual ~HeadlessShader() = default;
+
+		virtual void bind() const override;
+		virtual void unBind() const override {}
+
+		virtual void setMat4(const std::string& name, const glm::mat4& value) override {}
+		virtual void setFloat(const std::string& name, float value) override {}
+		virtual void setFloat3(const std::string& name, const glm::vec3& value) override {}
+		virtual void setFloat4(const std::string& name, const glm::vec4& value) override {}
+		virtual void setInt(const std::string& name, int value) override {}
+
+		virtual void setIntArray(const std::string& name, int* values, uint32_t count) override {}
+
+		virtual const std::string& getName() const override { return _name; }
+
+	private:
+		std::string _name;
+	};
+}
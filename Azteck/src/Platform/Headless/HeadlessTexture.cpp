@@ -0,0 +1,81 @@
+#include "azpch.h"
+#include "HeadlessTexture.h"
+#include "RenderRecorder.h"
+
+#include <stb_image.h>
+
+namespace Azteck
+{
+	namespace Utils
+	{
+		// Textures are compared by id, so every instance still needs its own
+		static uint32_t nextHeadlessTextureId()
+		{
+			static std::atomic<uint32_t> nextId = 1;
+			return nextId++;
+		}
+
+		static uint32_t bytesPerPixel(ImageFormat format)
+		{
+			switch (format)
+			{
+				case ImageFormat::R8:      return 1;
+				case ImageFormat::RGB8:    return 3;
+				case ImageFormat::RGBA8:   return 4;
+				case ImageFormat::RGBA32F: return 16;
+			}
+
+			AZ_CORE_ASSERT(false, "Unkown format");
+			return 0;
+		}
+	}
+
+	HeadlessTexture2D::HeadlessTexture2D(const std::string& path)
+		: _path(path)
+		, _rendererId(Utils::nextHeadlessTextureId())
+		, _isLoaded(false)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		// Only the header is read, the pixels are never needed
+		int width, height, channels;
+		if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			_spec.width = width;
+			_spec.height = height;
+			_spec.format = channels == 3 ? ImageFormat::RGB8 : ImageFormat::RGBA8;
+			_isLoaded = true;
+		}
+	}
+
+	HeadlessTexture2D::HeadlessTexture2D(const TextureSpecification& specification)
+		: _spec(specification)
+		, _rendererId(Utils::nextHeadlessTextureId())
+		, _isLoaded(true)
+	{
+	}
+
+	void HeadlessTexture2D::setData(void* data, uint32_t size)
+	{
+		AZ_CORE_ASSERT(size == _spec.width * _spec.height * Utils::bytesPerPixel(_spec.format), "Data must be entire texture");
+
+		RenderRecorder::record(RenderRecorder::CommandType::UploadTexture, size, data);
+	}
+
+	void HeadlessTexture2D::setSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		AZ_CORE_ASSERT(x + width <= _spec.width && y + height <= _spec.height, "Region is outside of the texture");
+
+		RenderRecorder::record(RenderRecorder::CommandType::UploadTexture, width * height * Utils::bytesPerPixel(_spec.format), data);
+	}
+
+	void HeadlessTexture2D::bind(uint32_t slot) const
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::BindTexture, slot);
+	}
+
+	bool HeadlessTexture2D::operator==(const Texture& other) const
+	{
+		return _rendererId == other.getRendererID();
+	}
+}
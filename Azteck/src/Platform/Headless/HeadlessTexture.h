@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Azteck/Renderer/Texture.h"
+
+namespace Azteck
+{
+	// Has the size of the image it stands for but no pixel storage
+	class HeadlessTexture2D : public Texture2D
+	{
+	public:
+		HeadlessTexture2D(const std::string& path);
+		HeadlessTexture2D(const TextureSpecification& specification);
+
+		virtual ~HeadlessTexture2D() = default;
+
+		virtual const TextureSpecification& getSpecification() const override { return _spec; }
+
+		void setData(void* data, uint32_t size) override;
+		void setSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+
+		inline uint32_t getWidth() const override { return _spec.width; };
+		inline uint32_t getHeight() const override { return _spec.height; };
+		inline uint32_t getRendererID() const override { return _rendererId; };
+		inline const std::string& getPath() const override { return _path; };
+
+		virtual bool isLoaded() const override { return _isLoaded; }
+
+		void bind(uint32_t slot = 0) const override;
+
+		bool operator==(const Texture& other) const override;
+
+	private:
+		TextureSpecification _spec;
+
+		std::string _path;
+		uint32_t _rendererId;
+
+		bool _isLoaded;
+	};
+}
@@ -0,0 +1,18 @@
+#include "azpch.h"
+#include "HeadlessUniformBuffer.h"
+#include "RenderRecorder.h"
+
+namespace Azteck {
+
+	HeadlessUniformBuffer::HeadlessUniformBuffer(uint32_t size, uint32_t binding)
+		: _size(size)
+	{
+	}
+
+	void HeadlessUniformBuffer::setData(const void* data, uint32_t size, uint32_t offset)
+	{
+		AZ_CORE_ASSERT(offset + size <= _size, "Uniform data does not fit into the buffer");
+
+		RenderRecorder::record(RenderRecorder::CommandType::UploadUniforms, size, data);
+	}
+}
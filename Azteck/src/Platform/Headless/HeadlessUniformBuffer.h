@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Azteck/Renderer/UniformBuffer.h"
+
+namespace Azteck {
+
+	class HeadlessUniformBuffer : public UniformBuffer
+	{
+	public:
+		HeadlessUniformBuffer(uint32_t size, uint32_t binding);
+		virtual ~HeadlessUniformBuffer() = default;
+
+		virtual void setData(const void* data, uint32_t size, uint32_t offset = 0) override;
+	private:
+		uint32_t _size = 0;
+	};
+}
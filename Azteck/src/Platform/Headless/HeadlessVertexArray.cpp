@@ -0,0 +1,23 @@
+#include "azpch.h"
+#include "HeadlessVertexArray.h"
+#include "RenderRecorder.h"
+
+namespace Azteck
+{
+	void HeadlessVertexArray::bind() const
+	{
+		RenderRecorder::record(RenderRecorder::CommandType::BindVertexArray);
+	}
+
+	void HeadlessVertexArray::addVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+	{
+		AZ_CORE_ASSERT(vertexBuffer->getLayout().getElements().size(), "Vertex buffer has no layout");
+
+		_vertexBuffers.push_back(vertexBuffer);
+	}
+
+	void HeadlessVertexArray::setIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+	{
+		_indexBuffer = indexBuffer;
+	}
+}
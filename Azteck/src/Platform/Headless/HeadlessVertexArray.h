@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Azteck/Renderer/VertexArray.h"
+
+namespace Azteck
+{
+	class HeadlessVertexArray : public VertexArray
+	{
+	public:
+		HeadlessVertexArray() = default;
+		virtual ~HeadlessVertexArray() = default;
+
+		virtual void bind() const override;
+		virtual void unbind() const override {}
+
+		virtual void addVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+		virtual void setIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+
+		virtual const std::vector<Ref<VertexBuffer>>& getVertexBuffers() const override { return _vertexBuffers; }
+		virtual const Ref<IndexBuffer>& getIndexBuffer() const override { return _indexBuffer; }
+
+	private:
+		std::vector<Ref<VertexBuffer>> _vertexBuffers;
+		Ref<IndexBuffer> _indexBuffer;
+	};
+}
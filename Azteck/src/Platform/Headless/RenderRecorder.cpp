@@ -0,0 +1,88 @@
+#include "azpch.h"
+#include "RenderRecorder.h"
+
+namespace Azteck
+{
+	RenderRecorder::Statistics RenderRecorder::_stats;
+
+	bool RenderRecorder::_captureEnabled = false;
+	std::vector<RenderRecorder::Command> RenderRecorder::_commands;
+	std::vector<uint8_t> RenderRecorder::_capturedBytes;
+
+	void RenderRecorder::record(CommandType type, uint32_t count, const void* data)
+	{
+		switch (type)
+		{
+			case CommandType::Clear:
+			case CommandType::SetClearColor:
+			case CommandType::SetViewport:
+			case CommandType::SetLineWidth:
+				_stats.stateChanges++;
+				break;
+
+			case CommandType::DrawIndexed:
+				_stats.drawCalls++;
+				_stats.indicesDrawn += count;
+				break;
+
+			case CommandType::DrawLines:
+				_stats.drawCalls++;
+				_stats.lineVerticesDrawn += count;
+				break;
+
+			case CommandType::BindVertexArray:
+				_stats.vertexArrayBinds++;
+				break;
+
+			case CommandType::BindShader:
+				_stats.shaderBinds++;
+				break;
+
+			case CommandType::BindTexture:
+				_stats.textureBinds++;
+				break;
+
+			case CommandType::UploadVertices:
+				_stats.vertexBytesUploaded += count;
+				break;
+
+			case CommandType::UploadIndices:
+				_stats.indexBytesUploaded += count;
+				break;
+
+			case CommandType::UploadUniforms:
+				_stats.uniformBytesUploaded += count;
+				break;
+
+			case CommandType::UploadTexture:
+				_stats.textureBytesUploaded += count;
+				break;
+
+			default:
+				AZ_CORE_ASSERT(false, "Unknown render command type");
+				break;
+		}
+
+		if (!_captureEnabled)
+			return;
+
+		Command& command = _commands.emplace_back();
+		command.type = type;
+		command.count = count;
+		command.dataOffset = _capturedBytes.size();
+
+		if (data != nullptr)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			_capturedBytes.insert(_capturedBytes.end(), bytes, bytes + count);
+		}
+	}
+
+	void RenderRecorder::reset()
+	{
+		_stats = Statistics();
+
+		_commands.clear();
+		_capturedBytes.clear();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Azteck/Core/Core.h"
+
+namespace Azteck
+{
+	// Counts everything the headless backend is asked to do, so renderer work can be
+	// measured and checked without a GPU. Only meant to be used from the render thread
+	class RenderRecorder
+	{
+	public:
+		enum class CommandType
+		{
+			Clear = 0,
+			SetClearColor,
+			SetViewport,
+			SetLineWidth,
+			DrawIndexed,
+			DrawLines,
+			BindVertexArray,
+			BindShader,
+			BindTexture,
+			UploadVertices,
+			UploadIndices,
+			UploadUniforms,
+			UploadTexture
+		};
+
+		struct Command
+		{
+			CommandType type;
+			// Indices or vertices for draws, bytes for uploads, the slot for texture binds
+			uint32_t count = 0;
+			// Where the uploaded bytes start in getCapturedBytes
+			size_t dataOffset = 0;
+		};
+
+		struct Statistics
+		{
+			uint64_t drawCalls = 0;
+			uint64_t indicesDrawn = 0;
+			uint64_t lineVerticesDrawn = 0;
+
+			uint64_t vertexBytesUploaded = 0;
+			uint64_t indexBytesUploaded = 0;
+			uint64_t uniformBytesUploaded = 0;
+			uint64_t textureBytesUploaded = 0;
+
+			uint64_t stateChanges = 0;
+			uint64_t vertexArrayBinds = 0;
+			uint64_t shaderBinds = 0;
+			uint64_t textureBinds = 0;
+
+			inline uint64_t getTotalBytesUploaded() const { return vertexBytesUploaded + indexBytesUploaded + uniformBytesUploaded + textureBytesUploaded; }
+		};
+
+		static void record(CommandType type, uint32_t count = 0, const void* data = nullptr);
+
+		static void reset();
+		static const Statistics& getStatistics() { return _stats; }
+
+		// Keeps every command and a copy of every upload, off by default since it grows until reset
+		static void setCaptureEnabled(bool enabled) { _captureEnabled = enabled; }
+		static bool isCaptureEnabled() { return _captureEnabled; }
+
+		static const std::vector<Command>& getCommands() { return _commands; }
+		static const std::vector<uint8_t>& getCapturedBytes() { return _capturedBytes; }
+
+	private:
+		static Statistics _stats;
+
+		static bool _captureEnabled;
+		static std::vector<Command> _commands;
+		static std::vector<uint8_t> _capturedBytes;
+	};
+}
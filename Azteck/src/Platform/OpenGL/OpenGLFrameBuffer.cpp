@@ -115,6 +115,14 @@ namespace Azteck
 	OpenGLFrameBuffer::~OpenGLFrameBuffer()
 	{
 		cleanup();
+
+		for (auto& readback : _pixelReadbacks)
+		{
+			if (readback.fence)
+				glDeleteSync(static_cast<GLsync>(readback.fence));
+			if (readback.buffer)
+				glDeleteBuffers(1, &readback.buffer);
+		}
 	}
 
 	void OpenGLFrameBuffer::bind()
@@ -154,6 +162,79 @@ namespace Azteck
 		return pixelData;
 	}
 
+	void OpenGLFrameBuffer::readPixelAsync(uint32_t attachmentIndex, int x, int y)
+	{
+		AZ_CORE_ASSERT(attachmentIndex < _colorAttachmentSpecs.size(), "Invalid attachment index");
+
+		pollPixelReadbacks();
+
+		PixelReadback& readback = _pixelReadbacks[_pixelReadbackIndex];
+		_pixelReadbackIndex = (_pixelReadbackIndex + 1) % pixelReadbackCount;
+
+		// The ring is full, a newer read is worth more than the oldest one
+		if (readback.fence)
+			glDeleteSync(static_cast<GLsync>(readback.fence));
+
+		if (!readback.buffer)
+		{
+			glCreateBuffers(1, &readback.buffer);
+			glNamedBufferData(readback.buffer, sizeof(int), nullptr, GL_STREAM_READ);
+		}
+
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+
+		// With a pack buffer bound glReadPixels only records the copy
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		readback.serial = ++_pixelReadbackSerial;
+	}
+
+	bool OpenGLFrameBuffer::getAsyncPixel(int& outValue)
+	{
+		pollPixelReadbacks();
+
+		if (_asyncPixelSerial == 0)
+			return false;
+
+		outValue = _asyncPixel;
+		return true;
+	}
+
+	void OpenGLFrameBuffer::readColorAttachment(uint32_t attachmentIndex, void* outData, uint32_t size)
+	{
+		AZ_CORE_ASSERT(attachmentIndex < _colorAttachmentSpecs.size(), "Invalid attachment index");
+		AZ_CORE_ASSERT(_colorAttachmentSpecs[attachmentIndex].textureFormat == FrameBufferTextureFormat::RGBA8, "Only RGBA8 attachments can be read");
+		AZ_CORE_ASSERT(size >= _spec.width * _spec.height * 4, "Buffer is too small");
+
+		glGetTextureImage(_colorAttachments[attachmentIndex], 0, GL_RGBA, GL_UNSIGNED_BYTE, size, outData);
+	}
+
+	void OpenGLFrameBuffer::pollPixelReadbacks()
+	{
+		for (auto& readback : _pixelReadbacks)
+		{
+			if (!readback.fence)
+				continue;
+
+			GLsync fence = static_cast<GLsync>(readback.fence);
+			GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+			if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+				continue;
+
+			glDeleteSync(fence);
+			readback.fence = nullptr;
+
+			if (readback.serial > _asyncPixelSerial)
+			{
+				glGetNamedBufferSubData(readback.buffer, 0, sizeof(int), &_asyncPixel);
+				_asyncPixelSerial = readback.serial;
+			}
+		}
+	}
+
 	void OpenGLFrameBuffer::clearAttachment(uint32_t attachmentIndex, int value)
 	{
 		AZ_CORE_ASSERT(attachmentIndex < _colorAttachmentSpecs.size(), "Invalid attachment index");
@@ -16,6 +16,11 @@ namespace Azteck
 		virtual void resize(uint32_t width, uint32_t height) override;
 		virtual int readPixel(uint32_t attachmentIndex, int x, int y) override;
 
+		virtual void readPixelAsync(uint32_t attachmentIndex, int x, int y) override;
+		virtual bool getAsyncPixel(int& outValue) override;
+
+		virtual void readColorAttachment(uint32_t attachmentIndex, void* outData, uint32_t size) override;
+
 		virtual void clearAttachment(uint32_t attachmentIndex, int value) override;
 
 		virtual const FrameBufferSpecification& getSpecification() const override { return _spec; };
@@ -29,6 +34,8 @@ namespace Azteck
 	private:
 		void cleanup();
 
+		void pollPixelReadbacks();
+
 	private:
 		uint32_t _rendererId;
 		FrameBufferSpecification _spec;
@@ -38,5 +45,21 @@ namespace Azteck
 
 		std::vector<uint32_t> _colorAttachments;
 		std::vector<FramebufferTextureSpecification> _colorAttachmentSpecs;
+
+		// Pixel pack buffers the async reads go through, a fence tells when the copy landed
+		struct PixelReadback
+		{
+			uint32_t buffer = 0;
+			void* fence = nullptr;
+			uint64_t serial = 0;
+		};
+
+		static constexpr uint32_t pixelReadbackCount = 3;
+		std::array<PixelReadback, pixelReadbackCount> _pixelReadbacks;
+		uint32_t _pixelReadbackIndex = 0;
+		uint64_t _pixelReadbackSerial = 0;
+
+		uint64_t _asyncPixelSerial = 0;
+		int _asyncPixel = -1;
 	};
 }
@@ -123,6 +123,14 @@ namespace Azteck
 		glTextureSubImage2D(_renderedId, 0, 0, 0, _width, _height, _dataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
+	void OpenGLTexture2D::setSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		AZ_PROFILE_FUNCTION();
+
+		AZ_CORE_ASSERT(x + width <= _width && y + height <= _height, "Region must be inside the texture");
+		glTextureSubImage2D(_renderedId, 0, x, y, width, height, _dataFormat, GL_UNSIGNED_BYTE, data);
+	}
+
 	void OpenGLTexture2D::bind(uint32_t slot) const
 	{
 		AZ_PROFILE_FUNCTION();
@@ -17,6 +17,7 @@ namespace Azteck
 		virtual const TextureSpecification& getSpecification() const override { return _spec; }
 
 		void setData(void* data, uint32_t size) override;
+		void setSubData(void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
 		inline uint32_t getWidth() const override { return _width; };
 		inline uint32_t getHeight() const override { return _height; };
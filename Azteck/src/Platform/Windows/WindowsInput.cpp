@@ -8,6 +8,10 @@ namespace Azteck
 {
 	bool Input::isKeyPressed(KeyCode keyCode)
 	{
+		// Headless applications have nothing to poll, all input reads as released
+		if (!Application::getInstance().hasWindow())
+			return false;
+
 		GLFWwindow* window = static_cast<GLFWwindow*>(Application::getInstance().getWindow().getNativeWindow());
 
 		if (window == nullptr)
@@ -22,6 +26,9 @@ namespace Azteck
 
 	bool Input::isMouseButtonPressed(MouseCode button)
 	{
+		if (!Application::getInstance().hasWindow())
+			return false;
+
 		GLFWwindow* window = static_cast<GLFWwindow*>(Application::getInstance().getWindow().getNativeWindow());
 
 		if (window == nullptr)
@@ -36,6 +43,9 @@ namespace Azteck
 
 	glm::vec2 Input::getMousePosition()
 	{
+		if (!Application::getInstance().hasWindow())
+			return { 0.0f, 0.0f };
+
 		GLFWwindow* window = static_cast<GLFWwindow*>(Application::getInstance().getWindow().getNativeWindow());
 
 		if (window == nullptr)
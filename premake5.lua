@@ -41,6 +41,8 @@ group ""
 
 group "Tools"
 	include "Azteck-Editor"
+	include "Azteck-Headless"
+	include "Azteck-Benchmarks"
 group ""
 
 group "Misc"